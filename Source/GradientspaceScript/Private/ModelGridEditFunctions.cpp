@@ -7,6 +7,7 @@
 #include "ModelGrid/ModelGrid.h"
 #include "ModelGrid/ModelGridEditor.h"
 #include "Grid/GSGridUtil.h"
+#include "Utility/GSUEModelGridUtil.h"
 
 #include "GSJobSubsystem.h"
 
@@ -62,7 +63,7 @@ UGSModelGrid* UGSScriptLibrary_ModelGridEdits::EraseGridCell(UGSModelGrid* Targe
 {
 	CHECK_GRID_VALID_OR_RETURN(TargetGridInOut, TEXT("EraseGridCell"));
 
-	TargetGridInOut->EditGrid([&](ModelGrid& Grid) {
+	TargetGridInOut->EditGridRegion(CellIndex, CellIndex, [&](ModelGrid& Grid) {
 		ModelGridEditor Editor(Grid);
 		Editor.EraseCell(CellIndex);
 	});
@@ -74,11 +75,8 @@ UGSModelGrid* UGSScriptLibrary_ModelGridEdits::EraseGridCellsInRange(UGSModelGri
 {
 	CHECK_GRID_VALID_OR_RETURN(TargetGridInOut, TEXT("EraseGridCellsInRange"));
 
-	TargetGridInOut->EditGrid([&](ModelGrid& Grid) {
-		ModelGridEditor Editor(Grid);
-		GS::EnumerateCellsInRangeInclusive(IndexRange.Min, IndexRange.Max, [&](Vector3i CellIndex) {
-			Editor.EraseCell(CellIndex);
-		});
+	TargetGridInOut->EditGridRegion(IndexRange.Min, IndexRange.Max, [&](ModelGrid& Grid) {
+		GS::EraseModelGridCellsInRange(Grid, IndexRange.Min, IndexRange.Max);
 	});
 	return TargetGridInOut;
 }
@@ -91,7 +89,7 @@ UGSModelGrid* UGSScriptLibrary_ModelGridEdits::FillGridCell(UGSModelGrid* Target
 
 	ModelGridCell NewCell = MakeDefaultCellFromType(EModelGridCellType::Filled);
 	NewCell.SetToSolidColor(GS::Color3b(CellColor));
-	TargetGridInOut->EditGrid([&](ModelGrid& Grid) {
+	TargetGridInOut->EditGridRegion(CellIndex, CellIndex, [&](ModelGrid& Grid) {
 		ModelGridEditor Editor(Grid);
 		Editor.UpdateCell(CellIndex, NewCell);
 	});
@@ -106,26 +104,17 @@ UGSModelGrid* UGSScriptLibrary_ModelGridEdits::FillGridCellsInRangeV1(UGSModelGr
 
 	ModelGridCell NewCell = MakeDefaultCellFromType(EModelGridCellType::Filled);
 	NewCell.SetToSolidColor(GS::Color3b(CellColor));
-	TargetGridInOut->EditGrid([&](ModelGrid& Grid) {
-		ModelGridEditor Editor(Grid);
-		GS::EnumerateCellsInRangeInclusive(IndexRange.Min, IndexRange.Max, [&](Vector3i CellIndex) {
-			bool bIsInGrid = false;
-			EModelGridCellType CellType = Grid.GetCellType(CellIndex, bIsInGrid);
-			if ( (!bOnlyFillEmpty) || CellType == EModelGridCellType::Empty)
-				Editor.UpdateCell(CellIndex, NewCell);
-		});
+	TargetGridInOut->EditGridRegion(IndexRange.Min, IndexRange.Max, [&](ModelGrid& Grid) {
+		GS::FillModelGridCellsInRange(Grid, IndexRange.Min, IndexRange.Max, NewCell, bOnlyFillEmpty);
 	});
 	return TargetGridInOut;
 }
 
 
-UGSModelGrid* UGSScriptLibrary_ModelGridEdits::SetGridCellShapeV1(UGSModelGrid* TargetGridInOut, FIntVector CellIndex,
-	EModelGridBPCellType CellType,
-	const FModelGridCellTransformV1& CellTransform,
-	const FColor& CellColor)
-{
-	CHECK_GRID_VALID_OR_RETURN(TargetGridInOut, TEXT("SetGridCellShapeV1"));
+namespace GS {
 
+static ModelGridCell MakeCellFromShapeV1(EModelGridBPCellType CellType, const FModelGridCellTransformV1& CellTransform, const FColor& CellColor)
+{
 	ModelGridCell NewCell = MakeDefaultCellFromType((EModelGridCellType)(int)CellType);
 	if (ModelGridCellData_StandardRST::IsSubType(NewCell.CellType))
 	{
@@ -145,8 +134,22 @@ UGSModelGrid* UGSScriptLibrary_ModelGridEdits::SetGridCellShapeV1(UGSModelGrid*
 	}
 
 	NewCell.SetToSolidColor(GS::Color3b(CellColor));
+	return NewCell;
+}
 
-	TargetGridInOut->EditGrid([&](ModelGrid& Grid) {
+}
+
+
+UGSModelGrid* UGSScriptLibrary_ModelGridEdits::SetGridCellShapeV1(UGSModelGrid* TargetGridInOut, FIntVector CellIndex,
+	EModelGridBPCellType CellType,
+	const FModelGridCellTransformV1& CellTransform,
+	const FColor& CellColor)
+{
+	CHECK_GRID_VALID_OR_RETURN(TargetGridInOut, TEXT("SetGridCellShapeV1"));
+
+	ModelGridCell NewCell = GS::MakeCellFromShapeV1(CellType, CellTransform, CellColor);
+
+	TargetGridInOut->EditGridRegion(CellIndex, CellIndex, [&](ModelGrid& Grid) {
 		ModelGridEditor Editor(Grid);
 		Editor.UpdateCell(CellIndex, NewCell);
 	});
@@ -156,6 +159,14 @@ UGSModelGrid* UGSScriptLibrary_ModelGridEdits::SetGridCellShapeV1(UGSModelGrid*
 
 namespace GS {
 
+// union of source and translated target ranges, ie all cells that CopyGridCellsInRange may modify
+static void GetCopyGridCellsModifiedRange(const FGSIntBox3& IndexRange, const FIntVector& Translation, FIntVector& MinOut, FIntVector& MaxOut)
+{
+	FIntVector TargetMin = IndexRange.Min + Translation, TargetMax = IndexRange.Max + Translation;
+	MinOut = FIntVector(FMath::Min(IndexRange.Min.X, TargetMin.X), FMath::Min(IndexRange.Min.Y, TargetMin.Y), FMath::Min(IndexRange.Min.Z, TargetMin.Z));
+	MaxOut = FIntVector(FMath::Max(IndexRange.Max.X, TargetMax.X), FMath::Max(IndexRange.Max.Y, TargetMax.Y), FMath::Max(IndexRange.Max.Z, TargetMax.Z));
+}
+
 static void CopyGridCellsInRange(ModelGrid& Grid, GS::AxisBox3i IndexRange, GS::Vector3i Translation, bool bErasePrevious, bool bReplaceAtTarget)
 {
 	ModelGridEditor Editor(Grid);
@@ -195,7 +206,9 @@ UGSModelGrid* UGSScriptLibrary_ModelGridEdits::TranslateGridCellsInRangeV1(UGSMo
 
 	// todo: this could be smarter...can copy-in-place if we know positive/negative directions
 
-	TargetGridInOut->EditGrid([&](ModelGrid& Grid) {
+	FIntVector ModifiedMin, ModifiedMax;
+	GS::GetCopyGridCellsModifiedRange(IndexRange, Translation, ModifiedMin, ModifiedMax);
+	TargetGridInOut->EditGridRegion(ModifiedMin, ModifiedMax, [&](ModelGrid& Grid) {
 		GS::AxisBox3i IntRange(IndexRange.Min, IndexRange.Max);
 		GS::CopyGridCellsInRange(Grid, IntRange, Translation, true, true);
 	});
@@ -207,7 +220,9 @@ UGSModelGrid* UGSScriptLibrary_ModelGridEdits::CopyGridCellsInRangeV1(UGSModelGr
 	CHECK_GRID_VALID_OR_RETURN(TargetGridInOut, TEXT("CopyGridCellsInRangeV1"));
 	if (Translation.IsZero()) return TargetGridInOut;
 
-	TargetGridInOut->EditGrid([&](ModelGrid& Grid) {
+	FIntVector ModifiedMin, ModifiedMax;
+	GS::GetCopyGridCellsModifiedRange(IndexRange, Translation, ModifiedMin, ModifiedMax);
+	TargetGridInOut->EditGridRegion(ModifiedMin, ModifiedMax, [&](ModelGrid& Grid) {
 		GS::AxisBox3i IntRange(IndexRange.Min, IndexRange.Max);
 		GS::CopyGridCellsInRange(Grid, IntRange, Translation, false, !bOnlyFillEmpty);
 	});
@@ -215,4 +230,95 @@ UGSModelGrid* UGSScriptLibrary_ModelGridEdits::CopyGridCellsInRangeV1(UGSModelGr
 }
 
 
+
+void UGSModelGridEditBuffer::AddCellEdit(const FIntVector& CellIndex, const ModelGridCell& NewCell)
+{
+	if (CellIndices.Num() == 0) {
+		ModifiedMin = ModifiedMax = CellIndex;
+	} else {
+		ModifiedMin = FIntVector(FMath::Min(ModifiedMin.X, CellIndex.X), FMath::Min(ModifiedMin.Y, CellIndex.Y), FMath::Min(ModifiedMin.Z, CellIndex.Z));
+		ModifiedMax = FIntVector(FMath::Max(ModifiedMax.X, CellIndex.X), FMath::Max(ModifiedMax.Y, CellIndex.Y), FMath::Max(ModifiedMax.Z, CellIndex.Z));
+	}
+	CellIndices.Add(CellIndex);
+	Cells.Add(NewCell);
+}
+
+void UGSModelGridEditBuffer::Reset()
+{
+	CellIndices.Reset();
+	Cells.Reset();
+	ModifiedMin = ModifiedMax = FIntVector::ZeroValue;
+}
+
+void UGSModelGridEditBuffer::ApplyToGrid(ModelGrid& Grid) const
+{
+	// edits are applied in order, so later edits to the same cell replace earlier ones
+	ModelGridEditor Editor(Grid);
+	for (int32 k = 0; k < CellIndices.Num(); ++k)
+	{
+		if (Cells[k].CellType == EModelGridCellType::Empty)
+			Editor.EraseCell(CellIndices[k]);
+		else
+			Editor.UpdateCell(CellIndices[k], Cells[k]);
+	}
+}
+
+
+UGSModelGridEditBuffer* UGSScriptLibrary_ModelGridEdits::CreateGridEditBuffer()
+{
+	return NewObject<UGSModelGridEditBuffer>();
+}
+
+
+UGSModelGridEditBuffer* UGSScriptLibrary_ModelGridEdits::BufferEraseGridCell(UGSModelGridEditBuffer* EditBuffer, FIntVector CellIndex)
+{
+	CHECK_OBJ_VALID_OR_RETURN_OTHER(EditBuffer, EditBuffer, TEXT("EditBuffer"), TEXT("BufferEraseGridCell"));
+
+	EditBuffer->AddCellEdit(CellIndex, MakeDefaultCellFromType(EModelGridCellType::Empty));
+	return EditBuffer;
+}
+
+
+UGSModelGridEditBuffer* UGSScriptLibrary_ModelGridEdits::BufferFillGridCell(UGSModelGridEditBuffer* EditBuffer, FIntVector CellIndex,
+	const FColor& CellColor)
+{
+	CHECK_OBJ_VALID_OR_RETURN_OTHER(EditBuffer, EditBuffer, TEXT("EditBuffer"), TEXT("BufferFillGridCell"));
+
+	ModelGridCell NewCell = MakeDefaultCellFromType(EModelGridCellType::Filled);
+	NewCell.SetToSolidColor(GS::Color3b(CellColor));
+	EditBuffer->AddCellEdit(CellIndex, NewCell);
+	return EditBuffer;
+}
+
+
+UGSModelGridEditBuffer* UGSScriptLibrary_ModelGridEdits::BufferSetGridCellShapeV1(UGSModelGridEditBuffer* EditBuffer, FIntVector CellIndex,
+	EModelGridBPCellType CellType,
+	const FModelGridCellTransformV1& CellTransform,
+	const FColor& CellColor)
+{
+	CHECK_OBJ_VALID_OR_RETURN_OTHER(EditBuffer, EditBuffer, TEXT("EditBuffer"), TEXT("BufferSetGridCellShapeV1"));
+
+	EditBuffer->AddCellEdit(CellIndex, GS::MakeCellFromShapeV1(CellType, CellTransform, CellColor));
+	return EditBuffer;
+}
+
+
+UGSModelGrid* UGSScriptLibrary_ModelGridEdits::CommitGridEditBuffer(UGSModelGrid* TargetGridInOut, UGSModelGridEditBuffer* EditBuffer, bool bClearBuffer)
+{
+	CHECK_GRID_VALID_OR_RETURN(TargetGridInOut, TEXT("CommitGridEditBuffer"));
+	CHECK_OBJ_VALID_OR_RETURN_OTHER(EditBuffer, TargetGridInOut, TEXT("EditBuffer"), TEXT("CommitGridEditBuffer"));
+	if (EditBuffer->IsEmpty()) return TargetGridInOut;
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(UGSScriptLibrary_ModelGridEdits::CommitGridEditBuffer);
+
+	TargetGridInOut->EditGridRegion(EditBuffer->GetModifiedMin(), EditBuffer->GetModifiedMax(), [&](ModelGrid& Grid) {
+		EditBuffer->ApplyToGrid(Grid);
+	});
+
+	if (bClearBuffer)
+		EditBuffer->Reset();
+	return TargetGridInOut;
+}
+
+
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -19,9 +19,7 @@ UGSModelGrid*  UGSScriptLibrary_ModelGridMeshing::GenerateMeshForModelGridV1(
 	CHECK_OBJ_VALID_OR_RETURN_OTHER(TargetMesh, TargetGrid, TEXT("TargetMesh"), TEXT("GenerateMeshForModelGridV1"));
 
 	TSharedPtr<FModelGridMeshingOp::FModelGridData> SourceData = MakeShared<FModelGridMeshingOp::FModelGridData>();
-	TargetGrid->ProcessGrid([&](const GS::ModelGrid& Grid) {
-		SourceData->SourceGrid = Grid;
-	});
+	SourceData->SourceGrid = TargetGrid->GetGridSnapshot();
 
 	FModelGridMeshingOp MeshingOp;
 	MeshingOp.SourceData = SourceData;
@@ -7,9 +7,44 @@
 #include "GridActor/UGSModelGrid.h"
 #include "ModelGridScriptTypes.h"
 #include "GradientspaceScriptTypes.h"
+#include "ModelGrid/ModelGridCell.h"
 #include "ModelGridEditFunctions.generated.h"
 
 
+/**
+ * Command buffer of cell edits for a ModelGrid. Scripts that set many cells can add the edits to
+ * a buffer and then apply them with CommitGridEditBuffer(), which takes the grid lock once and posts a
+ * single change notification, instead of locking and notifying for each EraseGridCell/FillGridCell/etc call.
+ */
+UCLASS(BlueprintType, Transient, MinimalAPI)
+class UGSModelGridEditBuffer : public UObject
+{
+	GENERATED_BODY()
+public:
+	//! queue a cell edit. Cells of type Empty are erased. Later edits to the same cell replace earlier ones.
+	GRADIENTSPACESCRIPT_API void AddCellEdit(const FIntVector& CellIndex, const GS::ModelGridCell& NewCell);
+	GRADIENTSPACESCRIPT_API void Reset();
+
+	int32 GetNumEdits() const { return CellIndices.Num(); }
+	bool IsEmpty() const { return CellIndices.Num() == 0; }
+
+	//! apply all queued edits to Grid. Caller must hold the grid lock (ie call inside EditGrid).
+	GRADIENTSPACESCRIPT_API void ApplyToGrid(GS::ModelGrid& Grid) const;
+
+	//! inclusive range of edited cells, only valid if the buffer is not empty
+	const FIntVector& GetModifiedMin() const { return ModifiedMin; }
+	const FIntVector& GetModifiedMax() const { return ModifiedMax; }
+
+protected:
+	// these arrays are 1-1
+	TArray<FIntVector> CellIndices;
+	TArray<GS::ModelGridCell> Cells;
+
+	FIntVector ModifiedMin = FIntVector::ZeroValue;
+	FIntVector ModifiedMax = FIntVector::ZeroValue;
+};
+
+
 
 UCLASS(meta = (ScriptName = "GSS_ModelGridEdits"), MinimalAPI)
 class UGSScriptLibrary_ModelGridEdits : public UBlueprintFunctionLibrary
@@ -69,4 +104,37 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Gradientspace|ModelGrid", meta = (ScriptMethod, DisplayName = "CopyGridCellsInRange", KeyWords = "gss, copy"))
 	static GRADIENTSPACESCRIPT_API UPARAM(DisplayName = "Target Grid") UGSModelGrid*
 	CopyGridCellsInRangeV1(UGSModelGrid* TargetGridInOut, const FGSIntBox3& IndexRange, const FIntVector& Translation, bool bOnlyFillEmpty = false);
+
+
+	/**
+	 * Create a new empty Grid Edit Buffer. Cell edits can be added to the buffer with the BufferEraseGridCell/BufferFillGridCell/etc
+	 * functions, and then applied to a Grid with CommitGridEditBuffer(). The Buffer can be re-used after it is committed.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Gradientspace|ModelGrid|EditBuffer", meta = (Keywords = "gss, batch"))
+	static GRADIENTSPACESCRIPT_API UPARAM(DisplayName = "Edit Buffer") UGSModelGridEditBuffer*
+	CreateGridEditBuffer();
+
+	UFUNCTION(BlueprintCallable, Category = "Gradientspace|ModelGrid|EditBuffer", meta = (ScriptMethod, KeyWords = "gss, erase, clear, batch"))
+	static GRADIENTSPACESCRIPT_API UPARAM(DisplayName = "Edit Buffer") UGSModelGridEditBuffer*
+	BufferEraseGridCell(UGSModelGridEditBuffer* EditBuffer, FIntVector CellIndex);
+
+	UFUNCTION(BlueprintCallable, Category = "Gradientspace|ModelGrid|EditBuffer", meta = (ScriptMethod, KeyWords = "gss, set, fill, batch"))
+	static GRADIENTSPACESCRIPT_API UPARAM(DisplayName = "Edit Buffer") UGSModelGridEditBuffer*
+	BufferFillGridCell(UGSModelGridEditBuffer* EditBuffer, FIntVector CellIndex,
+		const FColor& CellColor = FColor::White);
+
+	UFUNCTION(BlueprintCallable, Category = "Gradientspace|ModelGrid|EditBuffer", meta = (ScriptMethod, DisplayName = "BufferSetGridCellShape", KeyWords = "gss, set, fill, batch"))
+	static GRADIENTSPACESCRIPT_API UPARAM(DisplayName = "Edit Buffer") UGSModelGridEditBuffer*
+	BufferSetGridCellShapeV1(UGSModelGridEditBuffer* EditBuffer, FIntVector CellIndex,
+		EModelGridBPCellType CellType = EModelGridBPCellType::Filled,
+		const FModelGridCellTransformV1& CellTransform = FModelGridCellTransformV1(),
+		const FColor& CellColor = FColor::White);
+
+	/**
+	 * Apply all the edits in EditBuffer to TargetGrid, in a single grid edit with a single change notification.
+	 * @param bClearBuffer if true, the EditBuffer is emptied after the edits are applied
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Gradientspace|ModelGrid|EditBuffer", meta = (ScriptMethod, KeyWords = "gss, batch, apply"))
+	static GRADIENTSPACESCRIPT_API UPARAM(DisplayName = "Target Grid") UGSModelGrid*
+	CommitGridEditBuffer(UGSModelGrid* TargetGridInOut, UGSModelGridEditBuffer* EditBuffer, bool bClearBuffer = true);
 };
\ No newline at end of file
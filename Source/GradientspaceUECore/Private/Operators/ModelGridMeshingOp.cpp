@@ -632,9 +632,12 @@ void FModelGridMeshingOp::CalculateResult(FProgressCancel* Progress)
 
 bool FModelGridMeshingOp::CalculateResultInPlace(FDynamicMesh3& EditMesh, FProgressCancel* Progress)
 {
+	if (!SourceData.IsValid() || !SourceData->SourceGrid.IsValid())
+		return false;
+
 	// update mesh...
 	FDynamicMesh3 FinalMesh;
-	GS::ExtractGridFullMesh(SourceData->SourceGrid, FinalMesh, /*materials=*/true, /*uvs=*/true);
+	GS::ExtractGridFullMesh(*SourceData->SourceGrid, FinalMesh, /*materials=*/true, /*uvs=*/true);
 
 	// weld
 	if (FinalMesh.TriangleCount() > 0)
@@ -710,7 +713,7 @@ bool FModelGridMeshingOp::CalculateResultInPlace(FDynamicMesh3& EditMesh, FProgr
 		int UsePixelCount = FMathd::Clamp(DimensionPixelCount, 1, 2048);
 		int UseFacePixelBorder = FMathd::Clamp(UVIslandPixelBorder, 0, 64);
 		int AllocatedImageDims = 0;
-		if (PixelLayoutAndPack(FinalMesh, SourceData->SourceGrid.GetCellDimensions(), UsePixelCount, UseFacePixelBorder, AllocatedImageDims))
+		if (PixelLayoutAndPack(FinalMesh, SourceData->SourceGrid->GetCellDimensions(), UsePixelCount, UseFacePixelBorder, AllocatedImageDims))
 		{
 			PixelLayoutImageDimensionX_Result = PixelLayoutImageDimensionY_Result = AllocatedImageDims;
 		}
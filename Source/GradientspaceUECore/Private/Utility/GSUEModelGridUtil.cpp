@@ -8,6 +8,8 @@
 #include "ModelGrid/ModelGrid.h"
 #include "ModelGrid/ModelGridMesher.h"
 #include "ModelGrid/ModelGridMeshCache.h"
+#include "ModelGrid/ModelGridEditor.h"
+#include "Grid/GSGridUtil.h"
 
 //#define GSUE_FORCE_SINGLE_THREAD
 
@@ -77,3 +79,107 @@ void GS::ExtractGridFullMesh(
 	TempLock.Unlock();
 #endif
 }
+
+
+
+namespace GS
+{
+	static bool ClipRangeToBox(Vector3i& MinCell, Vector3i& MaxCell, const AxisBox3i& Box)
+	{
+		MinCell = Vector3i(FMath::Max(MinCell.X, Box.Min.X), FMath::Max(MinCell.Y, Box.Min.Y), FMath::Max(MinCell.Z, Box.Min.Z));
+		MaxCell = Vector3i(FMath::Min(MaxCell.X, Box.Max.X), FMath::Min(MaxCell.Y, Box.Max.Y), FMath::Min(MaxCell.Z, Box.Max.Z));
+		return MinCell.X <= MaxCell.X && MinCell.Y <= MaxCell.Y && MinCell.Z <= MaxCell.Z;
+	}
+
+	static int64 GetRangeVolume(const Vector3i& MinCell, const Vector3i& MaxCell)
+	{
+		return (int64)(MaxCell.X - MinCell.X + 1) * (int64)(MaxCell.Y - MinCell.Y + 1) * (int64)(MaxCell.Z - MinCell.Z + 1);
+	}
+}
+
+
+void GS::FillModelGridCellsInRange(
+	GS::ModelGrid& Grid,
+	const GS::Vector3i& MinCell, const GS::Vector3i& MaxCell,
+	const GS::ModelGridCell& NewCell,
+	bool bOnlyFillEmpty)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(GS::FillModelGridCellsInRange);
+	if (MinCell.X > MaxCell.X || MinCell.Y > MaxCell.Y || MinCell.Z > MaxCell.Z)
+		return;
+
+	ModelGridEditor Editor(Grid);
+	if (bOnlyFillEmpty == false)
+	{
+		GS::EnumerateCellsInRangeInclusive(MinCell, MaxCell, [&](Vector3i CellIndex) {
+			Editor.UpdateCell(CellIndex, NewCell);
+		});
+		return;
+	}
+
+	// region must be captured before filling, as it grows with each new cell
+	AxisBox3i ExistingRegion = Grid.GetModifiedRegionBounds(0);
+	bool bHaveExistingCells = ExistingRegion.IsValid();
+
+	// all cells outside the existing region are empty, so the cell type only needs to be queried inside it
+	Vector3i ClipMin = MinCell, ClipMax = MaxCell;
+	if (bHaveExistingCells == false || GS::ClipRangeToBox(ClipMin, ClipMax, ExistingRegion) == false)
+	{
+		GS::EnumerateCellsInRangeInclusive(MinCell, MaxCell, [&](Vector3i CellIndex) {
+			Editor.UpdateCell(CellIndex, NewCell);
+		});
+		return;
+	}
+
+	GS::EnumerateCellsInRangeInclusive(MinCell, MaxCell, [&](Vector3i CellIndex) {
+		bool bInClip = CellIndex.X >= ClipMin.X && CellIndex.X <= ClipMax.X
+			&& CellIndex.Y >= ClipMin.Y && CellIndex.Y <= ClipMax.Y
+			&& CellIndex.Z >= ClipMin.Z && CellIndex.Z <= ClipMax.Z;
+		bool bIsInGrid = false;
+		if (bInClip == false || Grid.GetCellType(CellIndex, bIsInGrid) == EModelGridCellType::Empty)
+			Editor.UpdateCell(CellIndex, NewCell);
+	});
+}
+
+
+void GS::EraseModelGridCellsInRange(
+	GS::ModelGrid& Grid,
+	const GS::Vector3i& MinCell, const GS::Vector3i& MaxCell)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(GS::EraseModelGridCellsInRange);
+
+	// cells outside the modified region are already empty
+	AxisBox3i ExistingRegion = Grid.GetModifiedRegionBounds(0);
+	if (ExistingRegion.IsValid() == false)
+		return;
+	Vector3i ClipMin = MinCell, ClipMax = MaxCell;
+	if (GS::ClipRangeToBox(ClipMin, ClipMax, ExistingRegion) == false)
+		return;
+
+	ModelGridEditor Editor(Grid);
+
+	// if most of the region is being erased, only visit the filled cells
+	int64 RangeVolume = GS::GetRangeVolume(ClipMin, ClipMax);
+	int64 RegionVolume = GS::GetRangeVolume(ExistingRegion.Min, ExistingRegion.Max);
+	if (RangeVolume * 4 >= RegionVolume)
+	{
+		// EnumerateFilledCells walks the grid's block storage, which EraseCell can modify (eg releasing an
+		// emptied block), so cells cannot be erased inside the callback and are collected first
+		TArray<Vector3i> EraseCells;
+		Grid.EnumerateFilledCells([&](Vector3i CellIndex, const ModelGridCell& Cell, AxisBox3d LocalBounds)
+		{
+			if (CellIndex.X >= ClipMin.X && CellIndex.Y >= ClipMin.Y && CellIndex.Z >= ClipMin.Z
+				&& CellIndex.X <= ClipMax.X && CellIndex.Y <= ClipMax.Y && CellIndex.Z <= ClipMax.Z)
+			{
+				EraseCells.Add(CellIndex);
+			}
+		});
+		for (Vector3i CellIndex : EraseCells)
+			Editor.EraseCell(CellIndex);
+		return;
+	}
+
+	GS::EnumerateCellsInRangeInclusive(ClipMin, ClipMax, [&](Vector3i CellIndex) {
+		Editor.EraseCell(CellIndex);
+	});
+}
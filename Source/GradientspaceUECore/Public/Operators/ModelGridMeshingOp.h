@@ -19,7 +19,8 @@ public:
 
 	struct FModelGridData
 	{
-		ModelGrid SourceGrid;
+		// immutable grid, may be a snapshot shared with a UGSModelGrid (see UGSModelGrid::GetGridSnapshot)
+		TSharedPtr<const ModelGrid> SourceGrid;
 	};
 
 
@@ -6,6 +6,8 @@
 
 #include "Core/SharedPointer.h"
 #include "ModelGrid/MaterialReferenceSet.h"
+#include "ModelGrid/ModelGridCell.h"
+#include "Math/GSIntVector3.h"
 
 namespace GS { class ModelGrid; }
 namespace UE::Geometry { class FDynamicMesh3; }
@@ -29,5 +31,28 @@ void ExtractGridFullMesh(
 	bool bEnableUVs,
 	GS::SharedPtr<ICellMaterialToIndexMap> GridMaterialMap,
 	FProgressCancel* Progress = nullptr);
-	
+
+
+/**
+ * Set all cells in the inclusive index range [MinCell,MaxCell] to NewCell. If bOnlyFillEmpty is true, 
+ * only empty cells are set. Cells outside the current modified region of the Grid are known to be empty, 
+ * so the per-cell type query is only done for cells inside it.
+ */
+GRADIENTSPACEUECORE_API
+void FillModelGridCellsInRange(
+	GS::ModelGrid& Grid,
+	const GS::Vector3i& MinCell, const GS::Vector3i& MaxCell,
+	const GS::ModelGridCell& NewCell,
+	bool bOnlyFillEmpty);
+
+/**
+ * Erase all cells in the inclusive index range [MinCell,MaxCell]. The range is clipped to the modified region
+ * of the Grid (all cells outside it are empty). If the clipped range covers a large part of the modified 
+ * region, the filled cells are enumerated instead of visiting every cell in the range.
+ */
+GRADIENTSPACEUECORE_API
+void EraseModelGridCellsInRange(
+	GS::ModelGrid& Grid,
+	const GS::Vector3i& MinCell, const GS::Vector3i& MaxCell);
+
 }
@@ -4,9 +4,33 @@
 
 #include "GameFramework/Actor.h"
 #include "GridActor/GeneratedModelGridActor.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
 
 bool UGSGenerationSubsystem::bIsGenerationSubsystemShuttingDown = false;
 
+namespace GS
+{
+static TAutoConsoleVariable<float> CVarGenerationFrameBudgetMs(
+	TEXT("gradientspace.Generation.FrameBudgetMs"),
+	5.0f,
+	TEXT("Per-frame time budget (in milliseconds) for regenerating pending Generated actors. At least one actor is regenerated each frame. 0 = no limit."));
+
+// squared distance from the actor to the nearest view rendered in its world last frame, or max-double if there are no views
+static double GetSquaredDistanceToNearestView(const AActor* Actor)
+{
+	double MinDistSqr = TNumericLimits<double>::Max();
+	if (const UWorld* World = Actor->GetWorld())
+	{
+		FVector ActorLocation = Actor->GetActorLocation();
+		for (const FVector& ViewLocation : World->ViewLocationsRenderedLastFrame)
+			MinDistSqr = FMath::Min(MinDistSqr, FVector::DistSquared(ActorLocation, ViewLocation));
+	}
+	return MinDistSqr;
+}
+}
+
 
 UGSGenerationSubsystem::UGSGenerationSubsystem()
 {
@@ -15,19 +39,52 @@ UGSGenerationSubsystem::UGSGenerationSubsystem()
 
 void UGSGenerationSubsystem::Tick(float DeltaTime)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(UGSGenerationSubsystem::Tick);
+
+	// regeneration may mark other actors (or the same actor) as pending, those will be processed next frame
+	TArray<AGSGeneratedModelGridActor*> ProcessActors = PendingRegenerationModelGrids.Array();
+	PendingRegenerationModelGrids.Reset();
+
 	// If we discover any invalid actors during the iteration, we want to remove them.
 	// (otherwise they will generate log spam every frame)
 	TArray<AGSGeneratedModelGridActor*, TInlineAllocator<8>> ToRemove;
 
-	for (AGSGeneratedModelGridActor* Actor : ActiveGeneratedModelGrids)
+	struct FPendingActor
+	{
+		AGSGeneratedModelGridActor* Actor;
+		double DistanceSqr;
+	};
+	TArray<FPendingActor> SortedActors;
+	SortedActors.Reserve(ProcessActors.Num());
+	for (AGSGeneratedModelGridActor* Actor : ProcessActors)
 	{
 		bool bValid = Actor->IsValidLowLevel() && IsValid(Actor);
 		if (bValid)
-			Actor->ExecuteRegenerateIfPending();
+			SortedActors.Add(FPendingActor{ Actor, GS::GetSquaredDistanceToNearestView(Actor) });
 		else
 			ToRemove.Add(Actor);
 	}
 
+	// regenerate actors nearest to the camera first
+	SortedActors.StableSort([](const FPendingActor& A, const FPendingActor& B) { return A.DistanceSqr < B.DistanceSqr; });
+
+	const double BudgetMs = (double)GS::CVarGenerationFrameBudgetMs.GetValueOnGameThread();
+	const double FrameBudgetEndTime = FPlatformTime::Seconds() + BudgetMs / 1000.0;
+	bool bBudgetExhausted = false;
+	for (const FPendingActor& PendingActor : SortedActors)
+	{
+		AGSGeneratedModelGridActor* Actor = PendingActor.Actor;
+		if (bBudgetExhausted == false)
+		{
+			Actor->ExecuteRegenerateIfPending();
+			bBudgetExhausted = (BudgetMs > 0) && (FPlatformTime::Seconds() > FrameBudgetEndTime);
+		}
+
+		// regeneration may be paused, could not run yet (eg actor is not in a level), or is deferred by the budget
+		if (Actor->IsRegenerationPending())
+			PendingRegenerationModelGrids.Add(Actor);
+	}
+
 	ensureMsgf(ToRemove.Num() == 0, TEXT("[UGSGenerationSubsystem::Tick] Found invalid Actors during regeneration check..."));
 
 	for (AGSGeneratedModelGridActor* InvalidActor : ToRemove)
@@ -46,6 +103,7 @@ void UGSGenerationSubsystem::Deinitialize()
 {
 	UGSGenerationSubsystem::bIsGenerationSubsystemShuttingDown = true;
 	ActiveGeneratedModelGrids.Reset();
+	PendingRegenerationModelGrids.Reset();
 
 	FCoreDelegates::OnEnginePreExit.RemoveAll(this);
 }
@@ -56,6 +114,7 @@ void UGSGenerationSubsystem::OnShutdown()
 	UGSGenerationSubsystem::bIsGenerationSubsystemShuttingDown = true;
 
 	ActiveGeneratedModelGrids.Reset();
+	PendingRegenerationModelGrids.Reset();
 }
 
 
@@ -67,6 +126,8 @@ bool UGSGenerationSubsystem::RegisterGeneratedModelGrid(AGSGeneratedModelGridAct
 
 	if (ActiveGeneratedModelGrids.Contains(Actor) == false) {
 		ActiveGeneratedModelGrids.Add(Actor);
+		if (Actor->IsRegenerationPending())
+			PendingRegenerationModelGrids.Add(Actor);
 		return true;
 	}
 	return false;
@@ -79,12 +140,23 @@ bool UGSGenerationSubsystem::UnregisterGeneratedModelGrid(AGSGeneratedModelGridA
 
 	if (ActiveGeneratedModelGrids.Contains(Actor)) {
 		ActiveGeneratedModelGrids.Remove(Actor);
+		PendingRegenerationModelGrids.Remove(Actor);
 		return true;
 	}
 	return false;
 }
 
 
+void UGSGenerationSubsystem::MarkModelGridRegenerationPending(AGSGeneratedModelGridActor* Actor)
+{
+	if (UGSGenerationSubsystem::bIsGenerationSubsystemShuttingDown)
+		return;
+
+	if (ActiveGeneratedModelGrids.Contains(Actor))
+		PendingRegenerationModelGrids.Add(Actor);
+}
+
+
 bool UGSGenerationSubsystem::RegisterGeneratedActor(AActor* Actor)
 {
 	if (UGSGenerationSubsystem::bIsGenerationSubsystemShuttingDown)
@@ -117,9 +189,23 @@ bool UGSGenerationSubsystem::UnregisterGeneratedActor(AActor* Actor)
 
 
 
+void UGSGenerationSubsystem::NotifyRegenerationPending(AActor* Actor)
+{
+	if (UGSGenerationSubsystem::bIsGenerationSubsystemShuttingDown)
+		return;
+
+	UGSGenerationSubsystem* Subsystem = GEngine->GetEngineSubsystem<UGSGenerationSubsystem>();
+	if (!Subsystem) return;
+
+	if (AGSGeneratedModelGridActor* ModelGridActor = Cast<AGSGeneratedModelGridActor>(Actor))
+		Subsystem->MarkModelGridRegenerationPending(ModelGridActor);
+}
+
+
+
 bool UGSGenerationSubsystem::IsTickable() const
 {
-	return !ActiveGeneratedModelGrids.IsEmpty();
+	return !PendingRegenerationModelGrids.IsEmpty();
 }
 
 TStatId UGSGenerationSubsystem::GetStatId() const
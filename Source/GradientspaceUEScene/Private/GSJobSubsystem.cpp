@@ -3,6 +3,91 @@
 #include "Engine/Engine.h"
 #include "Tasks/Task.h"
 #include "Core/UEVersionCompat.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "GenericPlatform/GenericPlatformMisc.h"
+#include "Stats/Stats.h"
+#include "GradientspaceUELogging.h"
+
+
+DECLARE_STATS_GROUP(TEXT("GradientspaceJobs"), STATGROUP_GSJobs, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Queued Jobs"), STAT_GSJobs_QueueDepth, STATGROUP_GSJobs);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Running Jobs"), STAT_GSJobs_Running, STATGROUP_GSJobs);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Deferred GameThread Updates"), STAT_GSJobs_DeferredUpdates, STATGROUP_GSJobs);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Jobs Launched"), STAT_GSJobs_Launched, STATGROUP_GSJobs);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Jobs Cancelled/Superseded"), STAT_GSJobs_Cancelled, STATGROUP_GSJobs);
+DECLARE_CYCLE_STAT(TEXT("Launch Jobs"), STAT_GSJobs_LaunchJobs, STATGROUP_GSJobs);
+DECLARE_CYCLE_STAT(TEXT("GameThread Updates"), STAT_GSJobs_GameThreadUpdates, STATGROUP_GSJobs);
+
+
+namespace GS
+{
+static TAutoConsoleVariable<int32> CVarMaxConcurrentJobs(
+	TEXT("gradientspace.Jobs.MaxConcurrentJobs"),
+	0,
+	TEXT("Maximum number of Gradientspace background jobs that can execute at the same time. 0 = number of worker threads."));
+
+static TAutoConsoleVariable<float> CVarGameThreadBudgetMs(
+	TEXT("gradientspace.Jobs.GameThreadBudgetMs"),
+	4.0f,
+	TEXT("Per-frame time budget (in milliseconds) for running game-thread job updates. At least one update is run each frame."));
+
+static TAutoConsoleVariable<bool> CVarTickWhenIdle(
+	TEXT("gradientspace.Jobs.TickWhenIdle"),
+	false,
+	TEXT("If enabled, the Gradientspace job managers tick every frame even if no jobs are queued or running (legacy behavior)."));
+
+static int32 GetMaxConcurrentJobs()
+{
+	int32 MaxJobs = CVarMaxConcurrentJobs.GetValueOnGameThread();
+	return (MaxJobs > 0) ? MaxJobs : FMath::Max(1, FPlatformMisc::NumberOfWorkerThreadsToSpawn());
+}
+
+static void LogTimingHistogram(const TCHAR* Name, const UGSJobSubsystem::FJobTimingHistogram& Histogram)
+{
+	UE_LOG(LogGradientspace, Display, TEXT("  %s: %lld samples, avg %.3fms, max %.3fms"),
+		Name, Histogram.NumSamples, Histogram.GetAverageMs(), Histogram.MaxMs);
+	FString Buckets;
+	for (int32 k = 0; k < UGSJobSubsystem::FJobTimingHistogram::NumBuckets; ++k)
+	{
+		if (k < UGSJobSubsystem::FJobTimingHistogram::NumBuckets - 1)
+			Buckets += FString::Printf(TEXT("<%gms: %lld  "), UGSJobSubsystem::FJobTimingHistogram::BucketUpperBoundsMs[k], Histogram.BucketCounts[k]);
+		else
+			Buckets += FString::Printf(TEXT(">=%gms: %lld"), UGSJobSubsystem::FJobTimingHistogram::BucketUpperBoundsMs[k-1], Histogram.BucketCounts[k]);
+	}
+	UE_LOG(LogGradientspace, Display, TEXT("    %s"), *Buckets);
+}
+
+static void DumpJobStatistics()
+{
+	UGSJobSubsystem::FJobStatistics Stats = UGSJobSubsystem::GetJobStatistics();
+	UE_LOG(LogGradientspace, Display, TEXT("[UGSJobSubsystem] Job Statistics"));
+	UE_LOG(LogGradientspace, Display, TEXT("  Enqueued %lld  Launched %lld  Completed %lld  Discarded %lld  Cancelled %lld  Superseded %lld"),
+		Stats.NumEnqueued, Stats.NumLaunched, Stats.NumCompleted, Stats.NumDiscarded, Stats.NumCancelled, Stats.NumSuperseded);
+	UE_LOG(LogGradientspace, Display, TEXT("  QueueDepth %d (max %d)  Running %d  PendingGameThreadUpdates %d"),
+		Stats.QueueDepth, Stats.MaxQueueDepth, Stats.NumRunning, Stats.NumPendingGameThreadUpdates);
+	LogTimingHistogram(TEXT("WaitTime"), Stats.WaitTime);
+	LogTimingHistogram(TEXT("RunTime"), Stats.RunTime);
+	LogTimingHistogram(TEXT("GameThreadUpdateTime"), Stats.GameThreadUpdateTime);
+}
+
+static FAutoConsoleCommand DumpJobStatisticsCmd(
+	TEXT("gradientspace.Jobs.DumpStats"),
+	TEXT("Log statistics for the Gradientspace job subsystem"),
+	FConsoleCommandDelegate::CreateStatic(&DumpJobStatistics));
+
+static FAutoConsoleCommand ResetJobStatisticsCmd(
+	TEXT("gradientspace.Jobs.ResetStats"),
+	TEXT("Reset statistics for the Gradientspace job subsystem"),
+	FConsoleCommandDelegate::CreateStatic(&UGSJobSubsystem::ResetJobStatistics));
+
+static bool IsHigherPriorityJob(const UGSJobSubsystem::FPendingJob& A, const UGSJobSubsystem::FPendingJob& B)
+{
+	if (A.Options.Priority != B.Options.Priority)
+		return (uint8)A.Options.Priority < (uint8)B.Options.Priority;
+	return A.ID.Timestamp < B.ID.Timestamp;
+}
+}
 
 UGSJobSubsystem::UGSJobSubsystem()
 {
@@ -14,12 +99,37 @@ UGSJobSubsystem::UGSJobSubsystem()
 uint64 UGSJobSubsystem::GetGlobalTickCounter()
 {
 	if (UGSJobSubsystem* Subsystem = GEngine->GetEngineSubsystem<UGSJobSubsystem>())
-		return Subsystem->GetGlobalTickCounter();
+		return Subsystem->DefaultJobManager->GetGlobalTickCounter();
 	return 0;
 }
 
 
-void UGSJobSubsystem::EnqueueStandardJob(
+void UGSJobSubsystem::FJobTimingHistogram::AddSample(double TimeMs)
+{
+	int32 Bucket = 0;
+	while (Bucket < NumBuckets - 1 && TimeMs >= BucketUpperBoundsMs[Bucket])
+		Bucket++;
+	BucketCounts[Bucket]++;
+	NumSamples++;
+	TotalMs += TimeMs;
+	MaxMs = FMath::Max(MaxMs, TimeMs);
+}
+
+UGSJobSubsystem::FJobStatistics UGSJobSubsystem::GetJobStatistics()
+{
+	if (UGSJobSubsystem* Subsystem = GEngine ? GEngine->GetEngineSubsystem<UGSJobSubsystem>() : nullptr)
+		return Subsystem->DefaultJobManager->GetJobStatistics();
+	return FJobStatistics();
+}
+
+void UGSJobSubsystem::ResetJobStatistics()
+{
+	if (UGSJobSubsystem* Subsystem = GEngine ? GEngine->GetEngineSubsystem<UGSJobSubsystem>() : nullptr)
+		Subsystem->DefaultJobManager->ResetJobStatistics();
+}
+
+
+UGSJobSubsystem::FJobHandle UGSJobSubsystem::EnqueueStandardJob(
 	UObject* Owner, UObject* Target,
 	TFunction<bool()>&& ComputeFunc,
 	TFunction<void()>&& GameThreadUpdateFunc,
@@ -27,13 +137,14 @@ void UGSJobSubsystem::EnqueueStandardJob(
 {
 	if (UGSJobSubsystem* Subsystem = GEngine->GetEngineSubsystem<UGSJobSubsystem>())
 	{
-		Subsystem->DefaultJobManager->EnqueueStandardJob(Owner, Target,
+		return Subsystem->DefaultJobManager->EnqueueStandardJob(Owner, Target,
 			MoveTemp(ComputeFunc), MoveTemp(GameThreadUpdateFunc), Options);
 	}
 	else
 	{
 		ensure(false);
 	}
+	return FJobHandle();
 }
 
 
@@ -53,14 +164,14 @@ void UGSJobSubsystem::EnqueueGameThreadTickJob(
 }
 
 
-void UBaseGSJobManager::EnqueueStandardJob(
+UGSJobSubsystem::FJobHandle UBaseGSJobManager::EnqueueStandardJob(
 	UObject* Owner, UObject* Target,
 	TFunction<bool()>&& ComputeFunc,
 	TFunction<void()>&& GameThreadUpdateFunc,
 	UGSJobSubsystem::FJobOptions Options)
 {
 	if (!ensure(IsValid(Owner) && IsValid(Target)))
-		return;
+		return UGSJobSubsystem::FJobHandle();
 
 	TimestampCounter++;
 
@@ -74,8 +185,40 @@ void UBaseGSJobManager::EnqueueStandardJob(
 	Job->ComputeFunc = MoveTemp(ComputeFunc);
 	Job->GameThreadUpdateFunc = MoveTemp(GameThreadUpdateFunc);
 	Job->Options = Options;
+	Job->EnqueueTime = FPlatformTime::Seconds();
 
+	int32 NumSuperseded = 0;
+	PendingJobsLock.Lock();
+	if (Options.DedupeKey != NAME_None)
+	{
+		// newer job replaces any not-yet-launched job with the same key
+		for (int32 k = PendingJobs.Num() - 1; k >= 0; --k)
+		{
+			const UGSJobSubsystem::FPendingJob& Existing = *PendingJobs[k];
+			if (Existing.Options.DedupeKey == Options.DedupeKey && Existing.ID.JobTarget == NewID.JobTarget)
+			{
+				PendingJobs[k]->bCancelled = true;
+				PendingJobs.RemoveAt(k);
+				NumSuperseded++;
+			}
+		}
+	}
 	PendingJobs.Add(Job);
+	int32 QueueDepth = PendingJobs.Num();
+	NumQueuedJobs = QueueDepth;
+	PendingJobsLock.Unlock();
+
+	UpdateStats([&](UGSJobSubsystem::FJobStatistics& UpdateStats) {
+		UpdateStats.NumEnqueued++;
+		UpdateStats.NumSuperseded += NumSuperseded;
+		UpdateStats.QueueDepth = QueueDepth;
+		UpdateStats.MaxQueueDepth = FMath::Max(UpdateStats.MaxQueueDepth, QueueDepth);
+	});
+	INC_DWORD_STAT_BY(STAT_GSJobs_Cancelled, NumSuperseded);
+
+	UGSJobSubsystem::FJobHandle Handle;
+	Handle.Job = Job;
+	return Handle;
 }
 
 
@@ -99,79 +242,238 @@ void UBaseGSJobManager::EnqueueGameThreadTickJob_ThreadSafe(
 
 	PendingTickJobsLock.Lock();
 	PendingTickJobs.Add(Job);
+	NumQueuedTickJobs = PendingTickJobs.Num();
 	PendingTickJobsLock.Unlock();
 }
 
 
 
+void UBaseGSJobManager::UpdateStats(TFunctionRef<void(UGSJobSubsystem::FJobStatistics&)> UpdateFunc)
+{
+	FScopeLock Lock(&StatsLock);
+	UpdateFunc(Stats);
+}
+
+UGSJobSubsystem::FJobStatistics UBaseGSJobManager::GetJobStatistics() const
+{
+	FScopeLock Lock(&StatsLock);
+	return Stats;
+}
+
+void UBaseGSJobManager::ResetJobStatistics()
+{
+	FScopeLock Lock(&StatsLock);
+	Stats = UGSJobSubsystem::FJobStatistics();
+}
+
+
 void UBaseGSJobManager::ExecuteStandardJob(TSharedPtr<UGSJobSubsystem::FPendingJob>& Job)
 {
-	if (Job->ID.JobOwner.IsValid() == false || Job->ID.JobTarget.IsValid() == false )
+	if (Job->ID.JobOwner.IsValid() == false || Job->ID.JobTarget.IsValid() == false || Job->bCancelled)
 	{
+		UpdateStats([&](UGSJobSubsystem::FJobStatistics& UpdateStats) { UpdateStats.NumCancelled++; });
+		INC_DWORD_STAT(STAT_GSJobs_Cancelled);
 		return;
 	}
 
+	Job->LaunchTime = FPlatformTime::Seconds();
+	UpdateStats([&](UGSJobSubsystem::FJobStatistics& UpdateStats) {
+		UpdateStats.NumLaunched++;
+		UpdateStats.WaitTime.AddSample((Job->LaunchTime - Job->EnqueueTime) * 1000.0);
+	});
+	INC_DWORD_STAT(STAT_GSJobs_Launched);
+
+	// run ComputeFunc and record the outcome. Returns true if the game thread update should run.
+	auto RunComputeFunc = [this](UGSJobSubsystem::FPendingJob& RunJob)
+	{
+		if (RunJob.bCancelled) {
+			UpdateStats([&](UGSJobSubsystem::FJobStatistics& UpdateStats) { UpdateStats.NumCancelled++; });
+			INC_DWORD_STAT(STAT_GSJobs_Cancelled);
+			return false;
+		}
+		double StartTime = FPlatformTime::Seconds();
+		bool bResult = RunJob.ComputeFunc();
+		double RunTimeMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+		UpdateStats([&](UGSJobSubsystem::FJobStatistics& UpdateStats) {
+			UpdateStats.RunTime.AddSample(RunTimeMs);
+			if (bResult == false)
+				UpdateStats.NumDiscarded++;
+		});
+		return bResult;
+	};
+
 	if (Job->Options.bComputeFuncIsThreadSafe)
 	{
-		UE::Tasks::FTask ComputeTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Job, this]()
+		NumRunningJobs++;
+		UE::Tasks::FTask ComputeTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Job, RunComputeFunc, this]()
 		{
-			if (Job->ComputeFunc())
+			bool bPostUpdate = RunComputeFunc(*Job);
+			if (bPostUpdate)
 			{
 				this->PendingGameThreadUpdatesLock.Lock();
 				PendingGameThreadUpdates.Add(Job);
+				NumQueuedGameThreadUpdates = PendingGameThreadUpdates.Num();
 				this->PendingGameThreadUpdatesLock.Unlock();
 			}
+			// decrement after posting the update, so IsTickable() never sees a finished job whose update is not queued yet
+			NumRunningJobs--;
 		});
 	}
 	else
 	{
-		if ( Job->ComputeFunc() )
-			Job->GameThreadUpdateFunc();
+		// the game thread update runs immediately after the compute, as it always has
+		if (RunComputeFunc(*Job))
+		{
+			if (Job->bCancelled == false)
+			{
+				double StartTime = FPlatformTime::Seconds();
+				Job->GameThreadUpdateFunc();
+				double UpdateTimeMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+				UpdateStats([&](UGSJobSubsystem::FJobStatistics& UpdateStats) {
+					UpdateStats.NumCompleted++;
+					UpdateStats.GameThreadUpdateTime.AddSample(UpdateTimeMs);
+				});
+			}
+			else
+			{
+				UpdateStats([&](UGSJobSubsystem::FJobStatistics& UpdateStats) { UpdateStats.NumCancelled++; });
+				INC_DWORD_STAT(STAT_GSJobs_Cancelled);
+			}
+		}
 	}
 }
 
 
-void UBaseGSJobManager::Tick(float DeltaTime)
+void UBaseGSJobManager::LaunchPendingJobs(double FrameBudgetEndTime)
 {
-	TimestampCounter++;
-	TickCounter++;
+	TRACE_CPUPROFILER_EVENT_SCOPE(UBaseGSJobManager::LaunchPendingJobs);
+	SCOPE_CYCLE_COUNTER(STAT_GSJobs_LaunchJobs);
+
+	TArray<TSharedPtr<UGSJobSubsystem::FPendingJob>> LaunchJobs;
+	PendingJobsLock.Lock();
+	int32 NumCancelled = PendingJobs.RemoveAll([](const TSharedPtr<UGSJobSubsystem::FPendingJob>& Job) { return Job->bCancelled.load(); });
+	PendingJobs.StableSort([](const TSharedPtr<UGSJobSubsystem::FPendingJob>& A, const TSharedPtr<UGSJobSubsystem::FPendingJob>& B) {
+		return GS::IsHigherPriorityJob(*A, *B);
+	});
+
+	// thread-safe jobs are limited by available concurrency. All game thread jobs are taken here, 
+	// they are limited by the frame budget as they are executed below
+	int32 AvailableSlots = GS::GetMaxConcurrentJobs() - NumRunningJobs;
+	for (int32 k = 0; k < PendingJobs.Num(); )
+	{
+		bool bLaunch = (PendingJobs[k]->Options.bComputeFuncIsThreadSafe == false) || (AvailableSlots > 0);
+		if (bLaunch)
+		{
+			if (PendingJobs[k]->Options.bComputeFuncIsThreadSafe)
+				AvailableSlots--;
+			LaunchJobs.Add(PendingJobs[k]);
+			GSUE::TArrayRemoveAt(PendingJobs, k, 1, false);
+		}
+		else
+			k++;
+	}
+	PendingJobsLock.Unlock();
 
-	while (PendingJobs.Num() > 0)
+	UpdateStats([&](UGSJobSubsystem::FJobStatistics& UpdateStats) { 
+		UpdateStats.NumCancelled += NumCancelled; 
+	});
+	INC_DWORD_STAT_BY(STAT_GSJobs_Cancelled, NumCancelled);
+
+	// game thread jobs run in ExecuteStandardJob, once we are out of time the remaining ones are returned to the queue
+	TArray<TSharedPtr<UGSJobSubsystem::FPendingJob>> DeferredJobs;
+	for (TSharedPtr<UGSJobSubsystem::FPendingJob>& Job : LaunchJobs)
 	{
-		TSharedPtr<UGSJobSubsystem::FPendingJob> Job = GSUE::TArrayPop(PendingJobs);
-		ExecuteStandardJob(Job);
+		if (Job->Options.bComputeFuncIsThreadSafe == false && FPlatformTime::Seconds() > FrameBudgetEndTime)
+			DeferredJobs.Add(Job);
+		else
+			ExecuteStandardJob(Job);
 	}
 
-	// run any pending gamethread updates
-	TArray<TSharedPtr<UGSJobSubsystem::FPendingJob>> GameThreadUpdates;
-	bool bHaveUpdates = false;
+	PendingJobsLock.Lock();
+	PendingJobs.Append(DeferredJobs);
+	int32 QueueDepth = PendingJobs.Num();
+	NumQueuedJobs = QueueDepth;
+	PendingJobsLock.Unlock();
+
+	UpdateStats([&](UGSJobSubsystem::FJobStatistics& UpdateStats) { UpdateStats.QueueDepth = QueueDepth; });
+}
+
+
+void UBaseGSJobManager::RunGameThreadUpdates(double FrameBudgetEndTime)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UBaseGSJobManager::RunGameThreadUpdates);
+	SCOPE_CYCLE_COUNTER(STAT_GSJobs_GameThreadUpdates);
+
 	PendingGameThreadUpdatesLock.Lock();
 	if (PendingGameThreadUpdates.Num() > 0)
 	{
-		GameThreadUpdates = PendingGameThreadUpdates;
-		bHaveUpdates = true;
+		DeferredGameThreadUpdates.Append(PendingGameThreadUpdates);
 		PendingGameThreadUpdates.Reset();
+		NumQueuedGameThreadUpdates = 0;
 	}
 	PendingGameThreadUpdatesLock.Unlock();
 
-	if (bHaveUpdates)
+	if (DeferredGameThreadUpdates.Num() == 0)
+		return;
+
+	DeferredGameThreadUpdates.StableSort([](const TSharedPtr<UGSJobSubsystem::FPendingJob>& A, const TSharedPtr<UGSJobSubsystem::FPendingJob>& B) {
+		return GS::IsHigherPriorityJob(*A, *B);
+	});
+
+	// always run at least one update per tick so that we make progress
+	int32 NumProcessed = 0;
+	while (NumProcessed < DeferredGameThreadUpdates.Num())
 	{
-		while (GameThreadUpdates.Num() > 0)
+		TSharedPtr<UGSJobSubsystem::FPendingJob>& Job = DeferredGameThreadUpdates[NumProcessed++];
+		if (Job->bCancelled == false && Job->ID.JobOwner.IsValid() && Job->ID.JobTarget.IsValid())
 		{
-			TSharedPtr<UGSJobSubsystem::FPendingJob> Job = GSUE::TArrayPop(GameThreadUpdates);
-			if (Job->ID.JobOwner.IsValid() && Job->ID.JobTarget.IsValid())
-			{
-				Job->GameThreadUpdateFunc();
-			}
+			double StartTime = FPlatformTime::Seconds();
+			Job->GameThreadUpdateFunc();
+			double EndTime = FPlatformTime::Seconds();
+			UpdateStats([&](UGSJobSubsystem::FJobStatistics& UpdateStats) {
+				UpdateStats.NumCompleted++;
+				UpdateStats.GameThreadUpdateTime.AddSample((EndTime - StartTime) * 1000.0);
+			});
+			if (EndTime > FrameBudgetEndTime)
+				break;
+		}
+		else
+		{
+			UpdateStats([&](UGSJobSubsystem::FJobStatistics& UpdateStats) { UpdateStats.NumCancelled++; });
+			INC_DWORD_STAT(STAT_GSJobs_Cancelled);
 		}
 	}
+	GSUE::TArrayRemoveAt(DeferredGameThreadUpdates, 0, NumProcessed, false);
+}
+
+
+void UBaseGSJobManager::Tick(float DeltaTime)
+{
+	TimestampCounter++;
+
+	const double FrameBudgetEndTime = FPlatformTime::Seconds() + (double)GS::CVarGameThreadBudgetMs.GetValueOnGameThread() / 1000.0;
+
+	LaunchPendingJobs(FrameBudgetEndTime);
 
+	RunGameThreadUpdates(FrameBudgetEndTime);
 
+	int32 NumRunning = NumRunningJobs;
+	int32 NumDeferred = DeferredGameThreadUpdates.Num();
+	int32 QueueDepth = 0;
+	UpdateStats([&](UGSJobSubsystem::FJobStatistics& UpdateStats) {
+		UpdateStats.NumRunning = NumRunning;
+		UpdateStats.NumPendingGameThreadUpdates = NumDeferred;
+		QueueDepth = UpdateStats.QueueDepth;
+	});
+	SET_DWORD_STAT(STAT_GSJobs_QueueDepth, QueueDepth);
+	SET_DWORD_STAT(STAT_GSJobs_Running, NumRunning);
+	SET_DWORD_STAT(STAT_GSJobs_DeferredUpdates, NumDeferred);
 
 	TArray<TSharedPtr<UGSJobSubsystem::FGameThreadTickJob>> RunTickJobs;
 	PendingTickJobsLock.Lock();
 	if (PendingTickJobs.Num() > 0)
 		::Swap(RunTickJobs, PendingTickJobs);
+	NumQueuedTickJobs = 0;
 	PendingTickJobsLock.Unlock();
 
 	for (auto Job : RunTickJobs) 
@@ -181,9 +483,12 @@ void UBaseGSJobManager::Tick(float DeltaTime)
 
 bool UBaseGSJobManager::IsTickable() const
 {
-	// todo need to also check PendingGameThreadUpdates but annoying to lock it, need some atomic?
-	return true;
-	//return (PendingJobs.Num() > 0);
+	// only tick while there is work in flight. The counters are updated under the 
+	// respective locks, DeferredGameThreadUpdates is only accessed on the game thread
+	if (GS::CVarTickWhenIdle.GetValueOnAnyThread())
+		return true;
+	return NumQueuedJobs > 0 || NumRunningJobs > 0 || NumQueuedGameThreadUpdates > 0 
+		|| NumQueuedTickJobs > 0 || DeferredGameThreadUpdates.Num() > 0;
 }
 
 TStatId UBaseGSJobManager::GetStatId() const
@@ -10,6 +10,9 @@
 #include "Async/ParallelFor.h"
 
 #include "MeshQueries.h"
+#include "DynamicMeshEditor.h"
+#include "Core/UEVersionCompat.h"
+#include "Intersection/IntrRay3AxisAlignedBox3.h"
 
 using namespace UE::Geometry;
 using namespace GS;
@@ -36,6 +39,19 @@ void UGSModelGridPreview::Initialize(UObject* Parent, UWorld* TargetWorld)
 
 void UGSModelGridPreview::Shutdown()
 {
+	// in-flight column task may reference data owned by the caller
+	if (PendingColumnBatch.IsValid()) {
+		PendingColumnUpdateTask.Wait();
+		PendingColumnBatch.Reset();
+	}
+	WaitForPendingCollisionUpdates();
+
+	// pooled and aggregate components are owned by the PreviewActor
+	ComponentPool.Reset();
+	MergeGroups.Reset();
+	UnmergedChunks.Reset();
+	PendingCollisionChunks.Reset();
+
 	if (PreviewActor) {
 		PreviewActor->Destroy();
 		PreviewActor = nullptr;
@@ -101,19 +117,10 @@ void UGSModelGridPreview::ParallelUpdateColumns(
 
 	TArray<FMeshChunk*, TInlineAllocator<16>> ProcessChunks;
 
-	for (GS::Vector2i Column : ColumnsToUpdate)
-	{
-		GS::Vector3i ChunkIndex(Column.X, Column.Y, 0);
-		TSharedPtr<FMeshChunk>* Found = MeshChunks.Find(ChunkIndex);
-		if (Found == nullptr)
-		{
-			TSharedPtr<FMeshChunk> NewChunk = MakeShared<FMeshChunk>();
-			NewChunk->ChunkIndex = ChunkIndex;
-			NewChunk->MeshComponent = SpawnNewComponent();
-
-			Found = &MeshChunks.Add(ChunkIndex, NewChunk);
-		}
-		ProcessChunks.Add(Found->Get());
+	for (GS::Vector2i Column : ColumnsToUpdate) {
+		FMeshChunk& Chunk = FindOrCreateColumnChunk(Column);
+		BeginChunkEdit(Chunk);
+		ProcessChunks.Add(&Chunk);
 	}
 
 	check(ProcessChunks.Num() == ColumnsToUpdate.Num());
@@ -125,12 +132,15 @@ void UGSModelGridPreview::ParallelUpdateColumns(
 		Chunk.MeshLock.Lock();
 		FDynamicMesh3* Mesh = Chunk.MeshComponent->GetMesh();
 		UpdateColumnMeshFunc(Column, *Mesh);
-		Chunk.bCollisionUpdatePending = true;
 		Chunk.MeshLock.Unlock();
 	});
 
-	for (FMeshChunk* Chunk : ProcessChunks)
+	for (FMeshChunk* Chunk : ProcessChunks) {
+		MarkCollisionDirty(*Chunk);
 		Chunk->MeshComponent->NotifyMeshUpdated();
+		EndChunkEdit(*Chunk);
+	}
+	RebuildModifiedMergeGroups();
 
 	//MeshCollisionUpdatesPending = true;
 	//PendingCollisionUpdateTask = UE::Tasks::Launch(TEXT("UpdateModelGridCollision"), [this, ProcessChunks]()
@@ -148,72 +158,530 @@ void UGSModelGridPreview::ParallelUpdateColumns(
 }
 
 
-void UGSModelGridPreview::BeginCollisionUpdate()
+UGSModelGridPreview::FMeshChunk& UGSModelGridPreview::FindOrCreateColumnChunk(GS::Vector2i Column)
+{
+	GS::Vector3i ChunkIndex(Column.X, Column.Y, 0);
+	TSharedPtr<FMeshChunk>* Found = MeshChunks.Find(ChunkIndex);
+	if (Found == nullptr)
+	{
+		// component is assigned in BeginChunkEdit()
+		TSharedPtr<FMeshChunk> NewChunk = MakeShared<FMeshChunk>();
+		NewChunk->ChunkIndex = ChunkIndex;
+
+		Found = &MeshChunks.Add(ChunkIndex, NewChunk);
+	}
+	return *Found->Get();
+}
+
+
+bool UGSModelGridPreview::AsyncUpdateColumns(
+	const TArray<GS::Vector2i>& ColumnsToUpdate,
+	TFunction<void(GS::Vector2i Column, FDynamicMesh3& Mesh)> UpdateColumnMeshFunc)
+{
+	if (PendingColumnBatch.IsValid())
+		return false;
+	if (ColumnsToUpdate.Num() == 0)
+		return true;
+
+	// new meshes are built into the batch, the components keep their current mesh until the batch is published
+	TSharedPtr<FColumnUpdateBatch> Batch = MakeShared<FColumnUpdateBatch>();
+	Batch->Columns = ColumnsToUpdate;
+	Batch->Meshes.SetNum(ColumnsToUpdate.Num());
+	PendingColumnBatch = Batch;
+
+	PendingColumnUpdateTask = UE::Tasks::Launch(TEXT("UpdateModelGridColumns"), [Batch, UpdateColumnMeshFunc = MoveTemp(UpdateColumnMeshFunc)]()
+	{
+		ParallelFor(Batch->Columns.Num(), [&](int Index)
+		{
+			UpdateColumnMeshFunc(Batch->Columns[Index], Batch->Meshes[Index]);
+		});
+	});
+
+	return true;
+}
+
+
+bool UGSModelGridPreview::PublishCompletedColumnUpdates(bool bWait)
 {
+	if (PendingColumnBatch.IsValid() == false)
+		return false;
+	if (bWait)
+		PendingColumnUpdateTask.Wait();
+	else if (PendingColumnUpdateTask.IsCompleted() == false)
+		return false;
+
+	TSharedPtr<FColumnUpdateBatch> Batch = MoveTemp(PendingColumnBatch);
+	PendingColumnBatch.Reset();
+
+	// collision task reads the component meshes
 	WaitForPendingCollisionUpdates();
-	bMeshCollisionUpdatesPending = true;
 
-	PendingCollisionUpdateTask = UE::Tasks::Launch(TEXT("UpdateModelGridCollision"), [this]()
+	for (int32 k = 0; k < Batch->Columns.Num(); ++k)
+	{
+		FMeshChunk& Chunk = FindOrCreateColumnChunk(Batch->Columns[k]);
+		BeginChunkEdit(Chunk);
+		Chunk.MeshLock.Lock();
+		Chunk.MeshComponent->SetMesh(MoveTemp(Batch->Meshes[k]));
+		Chunk.MeshLock.Unlock();
+		MarkCollisionDirty(Chunk);
+		EndChunkEdit(Chunk);
+	}
+	RebuildModifiedMergeGroups();
+
+	return true;
+}
+
+
+FDynamicMesh3& UGSModelGridPreview::GetChunkMesh(FMeshChunk& Chunk)
+{
+	UDynamicMeshComponent* Component = Chunk.MeshComponent.Get();
+	return (Component != nullptr) ? *Component->GetMesh() : Chunk.DetachedMesh;
+}
+
+
+UDynamicMeshComponent* UGSModelGridPreview::AcquireComponent()
+{
+	if (ComponentPool.Num() > 0)
+	{
+		UDynamicMeshComponent* Component = GSUE::TArrayPop(ComponentPool);
+		Component->RegisterComponent();
+		VisibleComponents.Add(Component);
+		return Component;
+	}
+	return SpawnNewComponent();
+}
+
+
+void UGSModelGridPreview::ReleaseComponent(UDynamicMeshComponent* Component)
+{
+	Component->SetMesh(FDynamicMesh3());
+	Component->UnregisterComponent();
+	VisibleComponents.RemoveSwap(Component);
+	ComponentPool.Add(Component);
+}
+
+
+void UGSModelGridPreview::BeginChunkEdit(FMeshChunk& Chunk)
+{
+	if (Chunk.bMerged)
+		UnmergeChunk(Chunk);
+
+	if (Chunk.MeshComponent.IsValid() == false)
+	{
+		UDynamicMeshComponent* Component = AcquireComponent();
+		Chunk.MeshLock.Lock();
+		Component->SetMesh(MoveTemp(Chunk.DetachedMesh));
+		Chunk.DetachedMesh = FDynamicMesh3();
+		Chunk.MeshComponent = Component;
+		Chunk.MeshLock.Unlock();
+	}
+
+	UnmergedChunks.Add(&Chunk);
+	Chunk.LastModifiedTime = FPlatformTime::Seconds();
+}
+
+
+void UGSModelGridPreview::EndChunkEdit(FMeshChunk& Chunk)
+{
+	UDynamicMeshComponent* Component = Chunk.MeshComponent.Get();
+	if (Component != nullptr && Component->GetMesh()->TriangleCount() == 0)
+	{
+		Chunk.MeshLock.Lock();
+		Chunk.MeshComponent = nullptr;
+		Chunk.MeshLock.Unlock();
+		ReleaseComponent(Component);
+		UnmergedChunks.Remove(&Chunk);
+	}
+}
+
+
+FIntPoint UGSModelGridPreview::GetMergeGroupIndex(const FMeshChunk& Chunk) const
+{
+	auto FloorDiv = [](int32 Value, int32 Divisor) { return (Value >= 0) ? (Value / Divisor) : ((Value - Divisor + 1) / Divisor); };
+	return FIntPoint(FloorDiv(Chunk.ChunkIndex.X, ChunkMergeGroupSize), FloorDiv(Chunk.ChunkIndex.Y, ChunkMergeGroupSize));
+}
+
+
+void UGSModelGridPreview::MergeChunk(FMeshChunk& Chunk)
+{
+	check(Chunk.bMerged == false);
+	UDynamicMeshComponent* Component = Chunk.MeshComponent.Get();
+	if (Component == nullptr)
+		return;
+
+	Chunk.MeshLock.Lock();
+	Chunk.DetachedMesh = MoveTemp(*Component->GetMesh());
+	Chunk.MeshComponent = nullptr;
+	Chunk.bMerged = true;
+	Chunk.MeshLock.Unlock();
+	ReleaseComponent(Component);
+	UnmergedChunks.Remove(&Chunk);
+
+	FMergeGroup& Group = MergeGroups.FindOrAdd(GetMergeGroupIndex(Chunk));
+	Group.Chunks.Add(&Chunk);
+	Group.bModified = true;
+}
+
+
+void UGSModelGridPreview::UnmergeChunk(FMeshChunk& Chunk)
+{
+	check(Chunk.bMerged);
+	Chunk.bMerged = false;
+	if (FMergeGroup* Group = MergeGroups.Find(GetMergeGroupIndex(Chunk)))
+	{
+		Group->Chunks.RemoveSwap(&Chunk);
+		Group->bModified = true;
+	}
+}
+
+
+void UGSModelGridPreview::RebuildModifiedMergeGroups()
+{
+	for (auto It = MergeGroups.CreateIterator(); It; ++It)
 	{
-		TArray<FMeshChunk*, TInlineAllocator<16>> Pending;
-		for (auto& Pair : MeshChunks) {
-			if (Pair.Value->bCollisionUpdatePending)
-				Pending.Add(Pair.Value.Get());
+		FMergeGroup& Group = It.Value();
+		if (Group.bModified == false)
+			continue;
+		Group.bModified = false;
+
+		FDynamicMesh3 CombinedMesh;
+		for (FMeshChunk* Chunk : Group.Chunks)
+		{
+			if (Chunk->DetachedMesh.TriangleCount() == 0)
+				continue;
+			if (CombinedMesh.TriangleCount() == 0)
+			{
+				CombinedMesh = Chunk->DetachedMesh;
+			}
+			else
+			{
+				FDynamicMeshEditor Editor(&CombinedMesh);
+				FMeshIndexMappings Tmp;
+				Editor.AppendMesh(&Chunk->DetachedMesh, Tmp);
+			}
+		}
+
+		UDynamicMeshComponent* Component = Group.Component.Get();
+		if (CombinedMesh.TriangleCount() == 0)
+		{
+			if (Component != nullptr)
+				ReleaseComponent(Component);
+			if (Group.Chunks.Num() == 0)
+				It.RemoveCurrent();
+			else
+				Group.Component = nullptr;
+			continue;
+		}
+
+		if (Component == nullptr)
+		{
+			Component = AcquireComponent();
+			Group.Component = Component;
 		}
+		Component->SetMesh(MoveTemp(CombinedMesh));
+	}
+}
+
+
+void UGSModelGridPreview::SetChunkMerging(bool bEnable, int32 MergeGroupSize, double MergeDelaySeconds)
+{
+	MergeGroupSize = FMath::Max(MergeGroupSize, 1);
+	if (bEnableChunkMerging && (bEnable == false || MergeGroupSize != ChunkMergeGroupSize))
+	{
+		// move all merged chunks back into their own components, so groups can be rebuilt with the new settings
+		WaitForPendingCollisionUpdates();
+		for (auto& Pair : MeshChunks)
+		{
+			if (Pair.Value->bMerged) {
+				BeginChunkEdit(*Pair.Value);
+				EndChunkEdit(*Pair.Value);
+			}
+		}
+		RebuildModifiedMergeGroups();
+	}
+
+	bEnableChunkMerging = bEnable;
+	ChunkMergeGroupSize = MergeGroupSize;
+	ChunkMergeDelaySeconds = FMath::Max(MergeDelaySeconds, 0.0);
+}
+
+
+void UGSModelGridPreview::UpdateChunkMerging()
+{
+	if (bEnableChunkMerging == false || UnmergedChunks.Num() == 0)
+		return;
+
+	double MergeTime = FPlatformTime::Seconds() - ChunkMergeDelaySeconds;
+	TArray<FMeshChunk*, TInlineAllocator<16>> ToMerge;
+	for (FMeshChunk* Chunk : UnmergedChunks)
+	{
+		if (Chunk->LastModifiedTime <= MergeTime)
+			ToMerge.Add(Chunk);
+	}
+	if (ToMerge.Num() == 0)
+		return;
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(UGSModelGridPreview::UpdateChunkMerging);
+
+	// collision task may be reading the component meshes
+	WaitForPendingCollisionUpdates();
+	for (FMeshChunk* Chunk : ToMerge)
+		MergeChunk(*Chunk);
+	RebuildModifiedMergeGroups();
+}
+
 
+void UGSModelGridPreview::MarkCollisionDirty(FMeshChunk& Chunk)
+{
+	// game thread only, collision task must not be running
+	PendingCollisionChunks.Add(&Chunk);
+}
+
+
+// hash of the vertex positions and triangles, ie the parts of the mesh that collision depends on
+static uint32 HashCollisionMeshGeometry(const FDynamicMesh3& Mesh)
+{
+	uint32 Hash = 0;
+	for (int32 vid : Mesh.VertexIndicesItr())
+		Hash = ::HashCombineFast(Hash, ::GetTypeHash(Mesh.GetVertex(vid)));
+	for (int32 tid : Mesh.TriangleIndicesItr())
+	{
+		FIndex3i Tri = Mesh.GetTriangle(tid);
+		Hash = ::HashCombineFast(Hash, ::HashCombineFast(::GetTypeHash(Tri.A), ::HashCombineFast(::GetTypeHash(Tri.B), ::GetTypeHash(Tri.C))));
+	}
+	return Hash;
+}
+
+
+void UGSModelGridPreview::BeginCollisionUpdate()
+{
+	WaitForPendingCollisionUpdates();
+	if (PendingCollisionChunks.Num() == 0)
+		return;
+
+	TArray<FMeshChunk*> Pending = PendingCollisionChunks.Array();
+	PendingCollisionChunks.Reset();
+	bool bRayGridValid = (ChunkRayGrid.Chunks.Num() > 0);
+
+	bMeshCollisionUpdatesPending = true;
+	PendingCollisionUpdateTask = UE::Tasks::Launch(TEXT("UpdateModelGridCollision"), [this, Pending = MoveTemp(Pending), bRayGridValid]()
+	{
+		std::atomic<bool> bBoundsChanged = (bRayGridValid == false);
 		ParallelFor(Pending.Num(), [&](int Index)
 		{
 			FMeshChunk& Chunk = *Pending[Index];
 
-			// copy mesh and rebuild BVH
+			// copy mesh and rebuild BVH, unless re-meshing produced the same geometry as the last build.
+			// Hashing is linear in the mesh size, much cheaper than the copy and BVH build it can skip
 			Chunk.MeshLock.Lock();
+			const FDynamicMesh3& ChunkMesh = GetChunkMesh(Chunk);
+			int32 VertexCount = ChunkMesh.VertexCount(), TriangleCount = ChunkMesh.TriangleCount();
+			uint32 MeshHash = HashCollisionMeshGeometry(ChunkMesh);
+			if (VertexCount == Chunk.CollisionVertexCount && TriangleCount == Chunk.CollisionTriangleCount && MeshHash == Chunk.CollisionMeshHash) {
+				Chunk.MeshLock.Unlock();
+				return;
+			}
 
 			if ( Chunk.CollisionBVH.GetMesh() == nullptr )
 				Chunk.CollisionBVH.SetMesh(&Chunk.CollisionMesh, false);
 
-			Chunk.CollisionMesh.Copy(*Chunk.MeshComponent->GetMesh(), false, false, false, false);
-			Chunk.bCollisionUpdatePending = false;
+			Chunk.CollisionMesh.Copy(ChunkMesh, false, false, false, false);
+			Chunk.CollisionVertexCount = VertexCount;
+			Chunk.CollisionTriangleCount = TriangleCount;
+			Chunk.CollisionMeshHash = MeshHash;
 			Chunk.MeshLock.Unlock();
 
 			Chunk.CollisionBVH.Build();
+
+			FAxisAlignedBox3d NewBounds = Chunk.CollisionMesh.GetBounds();
+			if (NewBounds.Min != Chunk.CollisionBounds.Min || NewBounds.Max != Chunk.CollisionBounds.Max)
+				bBoundsChanged = true;
+			Chunk.CollisionBounds = NewBounds;
 		});
 
+		// ray grid only depends on the chunk bounds
+		if (bBoundsChanged)
+			RebuildChunkRayGrid();
+
 		// done collision updates
 		bMeshCollisionUpdatesPending = false;
 	});
+}
 
 
+void UGSModelGridPreview::RebuildChunkRayGrid()
+{
+	FChunkRayGrid& RayGrid = ChunkRayGrid;
+	RayGrid.Chunks.Reset();
+	RayGrid.Bounds = FAxisAlignedBox3d::Empty();
+	RayGrid.CellStarts.Reset();
+	RayGrid.CellChunks.Reset();
+	RayGrid.Dimensions = FIntPoint::ZeroValue;
+
+	double MaxChunkExtent = 0;
+	for (auto& Pair : MeshChunks)
+	{
+		FMeshChunk& Chunk = *Pair.Value;
+		if (!Chunk.CollisionBVH.IsValid(false) || Chunk.CollisionBounds.IsEmpty())
+			continue;
+		RayGrid.Chunks.Add(&Chunk);
+		RayGrid.Bounds.Contain(Chunk.CollisionBounds);
+		MaxChunkExtent = FMath::Max3(MaxChunkExtent, Chunk.CollisionBounds.Width(), Chunk.CollisionBounds.Height());
+	}
+	if (RayGrid.Chunks.Num() == 0)
+		return;
+
+	// column meshes are all roughly the same XY size, so use the largest one as the cell size.
+	// Grow the cells if that would produce a huge grid (eg if most columns are nearly empty)
+	constexpr int64 MaxRayGridCells = 256 * 256;
+	RayGrid.Origin = FVector2d(RayGrid.Bounds.Min.X, RayGrid.Bounds.Min.Y);
+	RayGrid.CellSize = FMath::Max(MaxChunkExtent, UE_DOUBLE_KINDA_SMALL_NUMBER);
+	auto CountCells = [&](double Extent) { return FMath::Max(1, (int)FMath::CeilToDouble(Extent / RayGrid.CellSize)); };
+	while ( (int64)CountCells(RayGrid.Bounds.Width()) * (int64)CountCells(RayGrid.Bounds.Height()) > MaxRayGridCells )
+		RayGrid.CellSize *= 2.0;
+	RayGrid.Dimensions = FIntPoint(CountCells(RayGrid.Bounds.Width()), CountCells(RayGrid.Bounds.Height()));
+
+	auto GetCellRange = [&](const FAxisAlignedBox3d& Box, FIntPoint& MinCell, FIntPoint& MaxCell)
+	{
+		MinCell.X = FMath::Clamp((int)FMath::FloorToDouble((Box.Min.X - RayGrid.Origin.X) / RayGrid.CellSize), 0, RayGrid.Dimensions.X - 1);
+		MinCell.Y = FMath::Clamp((int)FMath::FloorToDouble((Box.Min.Y - RayGrid.Origin.Y) / RayGrid.CellSize), 0, RayGrid.Dimensions.Y - 1);
+		MaxCell.X = FMath::Clamp((int)FMath::FloorToDouble((Box.Max.X - RayGrid.Origin.X) / RayGrid.CellSize), 0, RayGrid.Dimensions.X - 1);
+		MaxCell.Y = FMath::Clamp((int)FMath::FloorToDouble((Box.Max.Y - RayGrid.Origin.Y) / RayGrid.CellSize), 0, RayGrid.Dimensions.Y - 1);
+	};
+
+	// counting pass, then fill the packed per-cell chunk lists
+	int32 NumCells = RayGrid.Dimensions.X * RayGrid.Dimensions.Y;
+	RayGrid.CellStarts.SetNumZeroed(NumCells + 1);
+	for (FMeshChunk* Chunk : RayGrid.Chunks)
+	{
+		FIntPoint MinCell, MaxCell;
+		GetCellRange(Chunk->CollisionBounds, MinCell, MaxCell);
+		for (int32 y = MinCell.Y; y <= MaxCell.Y; ++y)
+			for (int32 x = MinCell.X; x <= MaxCell.X; ++x)
+				RayGrid.CellStarts[y * RayGrid.Dimensions.X + x + 1]++;
+	}
+	for (int32 k = 0; k < NumCells; ++k)
+		RayGrid.CellStarts[k + 1] += RayGrid.CellStarts[k];
 
-
+	RayGrid.CellChunks.SetNumUninitialized(RayGrid.CellStarts[NumCells]);
+	TArray<int32> CellCounts;
+	CellCounts.SetNumZeroed(NumCells);
+	for (int32 ChunkIdx = 0; ChunkIdx < RayGrid.Chunks.Num(); ++ChunkIdx)
+	{
+		FIntPoint MinCell, MaxCell;
+		GetCellRange(RayGrid.Chunks[ChunkIdx]->CollisionBounds, MinCell, MaxCell);
+		for (int32 y = MinCell.Y; y <= MaxCell.Y; ++y)
+		{
+			for (int32 x = MinCell.X; x <= MaxCell.X; ++x)
+			{
+				int32 CellIdx = y * RayGrid.Dimensions.X + x;
+				RayGrid.CellChunks[RayGrid.CellStarts[CellIdx] + CellCounts[CellIdx]++] = ChunkIdx;
+			}
+		}
+	}
 }
 
 
 bool UGSModelGridPreview::FindRayIntersection(const FRay3d& WorldRay, FHitResult& HitOut)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(UGSModelGridPreview::FindRayIntersection);
 	WaitForPendingCollisionUpdates();
 
 	FRay3d LocalRay = WorldTransform.InverseTransformRay(WorldRay);
 
-	// todo could improve this a lot - DDA, test chunk bounds, etc
+	const FChunkRayGrid& RayGrid = ChunkRayGrid;
+	if (RayGrid.Chunks.Num() == 0)
+		return false;
+	double GridEntryT;
+	if (FIntrRay3AxisAlignedBox3d::FindIntersection(LocalRay, RayGrid.Bounds, GridEntryT) == false)
+		return false;
+
+	// clip the ray to the XY extents of the grid
+	const FVector2d GridMin = RayGrid.Origin;
+	const FVector2d GridMax = RayGrid.Origin + RayGrid.CellSize * FVector2d(RayGrid.Dimensions.X, RayGrid.Dimensions.Y);
+	double ClipMinT = 0, ClipMaxT = TNumericLimits<double>::Max();
+	for (int32 j = 0; j < 2; ++j)
+	{
+		if (FMath::Abs(LocalRay.Direction[j]) < UE_DOUBLE_SMALL_NUMBER)
+		{
+			if (LocalRay.Origin[j] < GridMin[j] || LocalRay.Origin[j] > GridMax[j])
+				return false;
+			continue;
+		}
+		double T0 = (GridMin[j] - LocalRay.Origin[j]) / LocalRay.Direction[j];
+		double T1 = (GridMax[j] - LocalRay.Origin[j]) / LocalRay.Direction[j];
+		if (T0 > T1) Swap(T0, T1);
+		ClipMinT = FMath::Max(ClipMinT, T0);
+		ClipMaxT = FMath::Min(ClipMaxT, T1);
+	}
+	if (ClipMinT > ClipMaxT)
+		return false;
+
+	// 2D DDA setup, starting in the cell containing the clipped ray start point
+	FVector2d StartPos = FVector2d(LocalRay.PointAt(ClipMinT));
+	int32 CellX = FMath::Clamp((int)FMath::FloorToDouble((StartPos.X - RayGrid.Origin.X) / RayGrid.CellSize), 0, RayGrid.Dimensions.X - 1);
+	int32 CellY = FMath::Clamp((int)FMath::FloorToDouble((StartPos.Y - RayGrid.Origin.Y) / RayGrid.CellSize), 0, RayGrid.Dimensions.Y - 1);
+	int32 Step[2]; double NextT[2]; double DeltaT[2];
+	int32 StartCell[2] = { CellX, CellY };
+	for (int32 j = 0; j < 2; ++j)
+	{
+		double Dir = LocalRay.Direction[j];
+		Step[j] = (Dir > 0) ? 1 : -1;
+		if (FMath::Abs(Dir) < UE_DOUBLE_SMALL_NUMBER) {
+			NextT[j] = DeltaT[j] = TNumericLimits<double>::Max();
+		} else {
+			double NextBoundary = RayGrid.Origin[j] + (double)(StartCell[j] + ((Step[j] > 0) ? 1 : 0)) * RayGrid.CellSize;
+			NextT[j] = (NextBoundary - LocalRay.Origin[j]) / Dir;
+			DeltaT[j] = RayGrid.CellSize / FMath::Abs(Dir);
+		}
+	}
+
+	// chunks can overlap multiple cells, only test each one once
+	TBitArray<> ChunkTested(false, RayGrid.Chunks.Num());
 
 	double NearHitDist = TNumericLimits<float>::Max();
 	int NearHitTID = -1;
 	FMeshChunk* NearHitChunk = nullptr;
-	for (auto& Pair : MeshChunks)
+	while (true)
 	{
-		FMeshChunk& Chunk = *Pair.Value;
-		if (! Chunk.CollisionBVH.IsValid(false)) 
-			continue;
-
-		double NearT; int HitTID;
-		if (Chunk.CollisionBVH.FindNearestHitTriangle(LocalRay, NearT, HitTID))
+		int32 CellIdx = CellY * RayGrid.Dimensions.X + CellX;
+		for (int32 k = RayGrid.CellStarts[CellIdx]; k < RayGrid.CellStarts[CellIdx + 1]; ++k)
 		{
-			if (NearT < NearHitDist) {
-				NearHitDist = NearT;
-				NearHitTID = HitTID;
-				NearHitChunk = &Chunk;
+			int32 ChunkIdx = RayGrid.CellChunks[k];
+			if (ChunkTested[ChunkIdx])
+				continue;
+			ChunkTested[ChunkIdx] = true;
+
+			FMeshChunk& Chunk = *RayGrid.Chunks[ChunkIdx];
+			double BoxEntryT;
+			if (FIntrRay3AxisAlignedBox3d::FindIntersection(LocalRay, Chunk.CollisionBounds, BoxEntryT) == false || BoxEntryT >= NearHitDist)
+				continue;
+
+			double NearT; int HitTID;
+			if (Chunk.CollisionBVH.FindNearestHitTriangle(LocalRay, NearT, HitTID))
+			{
+				if (NearT < NearHitDist) {
+					NearHitDist = NearT;
+					NearHitTID = HitTID;
+					NearHitChunk = &Chunk;
+				}
 			}
 		}
+
+		// any hit in the remaining cells is further away than the exit from this cell
+		double CellExitT = FMath::Min(NextT[0], NextT[1]);
+		if (NearHitDist <= CellExitT || CellExitT > ClipMaxT)
+			break;
+
+		if (NextT[0] < NextT[1]) {
+			CellX += Step[0];
+			NextT[0] += DeltaT[0];
+		} else {
+			CellY += Step[1];
+			NextT[1] += DeltaT[1];
+		}
+		if (CellX < 0 || CellX >= RayGrid.Dimensions.X || CellY < 0 || CellY >= RayGrid.Dimensions.Y)
+			break;
 	}
 	if (NearHitChunk == nullptr)
 		return false;
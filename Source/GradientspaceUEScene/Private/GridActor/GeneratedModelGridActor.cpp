@@ -2,6 +2,8 @@
 
 #include "GridActor/GeneratedModelGridActor.h"
 #include "GSGenerationSubsystem.h"
+#include "GridActor/UGSModelGrid.h"
+#include "ModelGrid/ModelGrid.h"
 #include "UObject/Package.h"
 #include "Engine/Level.h"
 #include "GradientspaceUELogging.h"
@@ -14,17 +16,25 @@ AGSGeneratedModelGridActor::~AGSGeneratedModelGridActor()
 
 void AGSGeneratedModelGridActor::MarkForRebuild()
 {
-	bRegenerationPending = true;
+	SetRegenerationPending();
 }
 
 
 void AGSGeneratedModelGridActor::RebuildImmediately(bool bEvenIfPaused)
 {
-	bRegenerationPending = true;
+	SetRegenerationPending();
 	ExecuteRegenerateIfPending(bEvenIfPaused);
 }
 
 
+void AGSGeneratedModelGridActor::SetRegenerationPending()
+{
+	bRegenerationPending = true;
+	if (bIsRegisteredWithGenerationManager)
+		UGSGenerationSubsystem::NotifyRegenerationPending(this);
+}
+
+
 void AGSGeneratedModelGridActor::ExecuteRegenerateIfPending(bool bOverridePause)
 {
 	if (bRegenerationPending == false)
@@ -61,6 +71,13 @@ void AGSGeneratedModelGridActor::ExecuteRegenerateIfPending(bool bOverridePause)
 	if (GridToEdit == nullptr)
 		return;
 
+	// if edits accumulate, regenerating directly into the grid already only modifies the edited cells
+	if (bUseGridDiffRegeneration && bClearGridBeforeRegenerate)
+	{
+		RegenerateWithGridDiff(GridToEdit);
+		return;
+	}
+
 	// run the edit
 	GridToEdit->BeginGridEdits();
 	{
@@ -76,6 +93,85 @@ void AGSGeneratedModelGridActor::ExecuteRegenerateIfPending(bool bOverridePause)
 }
 
 
+void AGSGeneratedModelGridActor::RegenerateWithGridDiff(UGSModelGrid* GridToEdit)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(AGSGeneratedModelGridActor::RegenerateWithGridDiff);
+
+	if (RegenerationScratchGrid == nullptr)
+		RegenerationScratchGrid = NewObject<UGSModelGrid>(this, NAME_None, RF_Transient);
+
+	// start from an empty grid with the same cell dimensions
+	TSharedPtr<const GS::ModelGrid> CurrentGrid = GridToEdit->GetGridSnapshot();
+	if (CurrentGrid.IsValid() == false)
+		return;
+	RegenerationScratchGrid->EditGrid([&](GS::ModelGrid& ScratchGrid)
+	{
+		ScratchGrid = GS::ModelGrid();
+		ScratchGrid.Initialize(CurrentGrid->GetCellDimensions());
+	});
+
+	// blocks that are occupied in the current grid must be compared, as they may be empty after regeneration.
+	// All filled cells are inside the modified region, so use its block range (O(blocks), not O(filled cells))
+	TSet<FIntVector> CandidateBlocks;
+	GS::AxisBox3i CurrentRegion = CurrentGrid->GetModifiedRegionBounds(0);
+	CurrentGrid.Reset();
+	if (CurrentRegion.IsValid())
+	{
+		FIntVector MinBlock = FModelGridChangeJournal::GetBlockIndex(FIntVector(CurrentRegion.Min.X, CurrentRegion.Min.Y, CurrentRegion.Min.Z));
+		FIntVector MaxBlock = FModelGridChangeJournal::GetBlockIndex(FIntVector(CurrentRegion.Max.X, CurrentRegion.Max.Y, CurrentRegion.Max.Z));
+		CandidateBlocks.Reserve((MaxBlock.X - MinBlock.X + 1) * (MaxBlock.Y - MinBlock.Y + 1) * (MaxBlock.Z - MinBlock.Z + 1));
+		for (int32 bz = MinBlock.Z; bz <= MaxBlock.Z; ++bz)
+			for (int32 by = MinBlock.Y; by <= MaxBlock.Y; ++by)
+				for (int32 bx = MinBlock.X; bx <= MaxBlock.X; ++bx)
+					CandidateBlocks.Add(FIntVector(bx, by, bz));
+	}
+
+	// the scratch grid change journal identifies the blocks written by the regeneration
+	FModelGridChangeJournal ScratchChanges;
+	FDelegateHandle ScratchChangesHandle = RegenerationScratchGrid->OnModelGridReplaced().AddLambda(
+		[&ScratchChanges](UGSModelGrid*, const FModelGridChangeJournal& ChangeJournal) { ScratchChanges.Append(ChangeJournal); });
+
+	RegenerationScratchGrid->BeginGridEdits();
+	{
+		FEditorScriptExecutionGuard Guard;
+		OnRegenerateModelGrid(RegenerationScratchGrid);
+
+		bRegenerationPending = false;
+	}
+	RegenerationScratchGrid->EndGridEdits();
+
+	RegenerationScratchGrid->OnModelGridReplaced().Remove(ScratchChangesHandle);
+
+	// commit only the blocks that changed
+	TSharedPtr<const GS::ModelGrid> NewGrid = RegenerationScratchGrid->GetGridSnapshot();
+	if (ScratchChanges.IsFullGridChange())
+	{
+		GridToEdit->UpdateModifiedBlocksFromGrid(*NewGrid);
+	}
+	else
+	{
+		if (ScratchChanges.bBlocksOverflowed && ScratchChanges.bHasModifiedCells)
+		{
+			FIntVector MinBlock = FModelGridChangeJournal::GetBlockIndex(ScratchChanges.ModifiedCellMin);
+			FIntVector MaxBlock = FModelGridChangeJournal::GetBlockIndex(ScratchChanges.ModifiedCellMax);
+			for (int32 bz = MinBlock.Z; bz <= MaxBlock.Z; ++bz)
+				for (int32 by = MinBlock.Y; by <= MaxBlock.Y; ++by)
+					for (int32 bx = MinBlock.X; bx <= MaxBlock.X; ++bx)
+						CandidateBlocks.Add(FIntVector(bx, by, bz));
+		}
+		else
+		{
+			CandidateBlocks.Append(ScratchChanges.ModifiedBlocks);
+		}
+		GridToEdit->UpdateModifiedBlocksFromGrid(*NewGrid, CandidateBlocks);
+	}
+	NewGrid.Reset();
+
+	// release the scratch grid storage until the next regeneration
+	RegenerationScratchGrid->ResetGrid();
+}
+
+
 
 
 
@@ -104,7 +200,7 @@ void AGSGeneratedModelGridActor::UnregisterWithGenerationManager()
 void AGSGeneratedModelGridActor::OnConstruction(const FTransform& Transform)
 {
 	Super::OnConstruction(Transform);
-	bRegenerationPending = true;
+	SetRegenerationPending();
 }
 
 void AGSGeneratedModelGridActor::PostLoad()
@@ -16,6 +16,8 @@
 #include "ModelGrid/ModelGridMeshCache.h"
 #include "DynamicMesh/Operations/MergeCoincidentMeshEdges.h"
 #include "Utility/GSUEModelGridUtil.h"
+#include "Core/DynamicMeshGenericAPI.h"
+#include "Async/ParallelFor.h"
 
 #define LOCTEXT_NAMESPACE "AGSModelGridActor"
 
@@ -84,12 +86,16 @@ void AGSModelGridActor::PostEditChangeProperty(FPropertyChangedEvent& PropertyCh
 		UGSJobSubsystem::EnqueueGameThreadTickJob(
 			this, this, [this]() { UpdatePreviewMeshState(); });
 	}
+	else if (PropName == GET_MEMBER_NAME_CHECKED(AGSModelGridActor, bUseChunkedPreviewMesh))
+	{
+		// recreate preview mesh components in the new mode on next tick
+		DestroyPreviewMeshComponents();
+		UGSJobSubsystem::EnqueueGameThreadTickJob(
+			this, this, [this]() { UpdatePreviewMeshState(); });
+	}
 	else if (PropName == GET_MEMBER_NAME_CHECKED(AGSModelGridActor, PreviewMeshCollisionMode))
 	{
-		if (PreviewMeshComponent) {
-			UpdatePreviewMeshCollisionState();
-			PreviewMeshComponent->UpdateCollision(true);
-		}
+		UpdateAllPreviewMeshCollision();
 	}
 }
 
@@ -99,7 +105,7 @@ void AGSModelGridActor::PreEditUndo()
 
 	// if the PMC becomes non-null in PostEditUndo we need to fix something...
 	// (also appears that the GridComponent Owner might be nullptr in this case?)
-	bPreviewMeshWasNullInLastPreEditUndo = (PreviewMeshComponent == nullptr);
+	bPreviewMeshWasNullInLastPreEditUndo = (HasPreviewMeshComponents() == false);
 }
 
 void AGSModelGridActor::PostEditUndo()
@@ -117,12 +123,9 @@ void AGSModelGridActor::PostEditUndo()
 	// Component explicitly here that will not happen. But we do not want to destroy in *every* undo/redo transaction.
 	// Naturally there is no direct way to check if (1) is this a redo and (2) is it an "actor-was-just-recreated" redo.
 	// So we rely on this hack instead, passing info between PreEditUndo() and PostEditUndo()
-	if (PreviewMeshComponent != nullptr && bPreviewMeshWasNullInLastPreEditUndo)
+	if (HasPreviewMeshComponents() && bPreviewMeshWasNullInLastPreEditUndo)
 	{
-		PreviewMeshComponent->UnregisterComponent();
-		PreviewMeshComponent->DetachFromComponent(FDetachmentTransformRules(EDetachmentRule::KeepRelative, false));
-		PreviewMeshComponent->DestroyComponent(false);
-		PreviewMeshComponent = nullptr;
+		DestroyPreviewMeshComponents();
 	}
 	
 	// don't start this update until after the transaction has completed
@@ -140,22 +143,97 @@ void AGSModelGridActor::UpdatePreviewMeshState()
 //	ensure(GUndo == nullptr);
 //#endif
 
-	if (bEnablePreviewMesh && PreviewMeshComponent == nullptr)
+	if (bEnablePreviewMesh && HasPreviewMeshComponents() == false)
 	{
-		OnModelGridChanged(GetGridComponent(), GetGrid());	// will launch compute job and then create PreviewMeshComponent
+		OnModelGridChanged(GetGridComponent(), GetGrid(), FModelGridChangeJournal::MakeFullGridChange());	// will launch compute job and then create PreviewMeshComponent
 	}
-	else if (PreviewMeshComponent != nullptr && bEnablePreviewMesh == false)
+	else if (HasPreviewMeshComponents() && bEnablePreviewMesh == false)
 	{
-		PreviewMeshComponent->UnregisterComponent();
-		PreviewMeshComponent->DetachFromComponent(FDetachmentTransformRules(EDetachmentRule::KeepRelative, false));
-		//PreviewMeshComponent->DetachFromParent(false, false);
-		PreviewMeshComponent->DestroyComponent(false);
-		PreviewMeshComponent = nullptr;
+		DestroyPreviewMeshComponents();
 		// is there something we can do to force update of details panel component tree? this doesn't do it...
 		//this->PostEditChange();
 	}
 }
 
+
+bool AGSModelGridActor::HasPreviewMeshComponents() const
+{
+	return PreviewMeshComponent != nullptr || PreviewChunkComponents.Num() > 0;
+}
+
+static void DestroyPreviewComponent(UDynamicMeshComponent* Component)
+{
+	Component->UnregisterComponent();
+	Component->DetachFromComponent(FDetachmentTransformRules(EDetachmentRule::KeepRelative, false));
+	//Component->DetachFromParent(false, false);
+	Component->DestroyComponent(false);
+}
+
+void AGSModelGridActor::DestroyPreviewMeshComponents()
+{
+	if (PreviewMeshComponent != nullptr)
+	{
+		DestroyPreviewComponent(PreviewMeshComponent);
+		PreviewMeshComponent = nullptr;
+	}
+	for (TPair<FIntPoint, TObjectPtr<UDynamicMeshComponent>>& Pair : PreviewChunkComponents)
+	{
+		if (Pair.Value != nullptr)
+			DestroyPreviewComponent(Pair.Value);
+	}
+	PreviewChunkComponents.Reset();
+
+	// next chunked update must be a full rebuild. An in-flight job was meshed for the destroyed 
+	// components, its completion must discard the result (see LaunchChunkedMeshRebuildJob)
+	ChunkMesher.Reset();
+	PendingMeshChanges.AddFullGridChange();
+	PreviewGeneration++;
+}
+
+
+UDynamicMeshComponent* AGSModelGridActor::CreatePreviewMeshComponent(FName ComponentName)
+{
+	UDynamicMeshComponent* NewComponent = NewObject<UDynamicMeshComponent>(this, ComponentName);
+
+	// have to explicitly set these flags because the uproperty markup will not be transferred to this new object
+	// Note that this slows down PIE quite a bit...possibly should only use TextExportTransient?
+	NewComponent->ClearFlags(RF_Transactional);
+	NewComponent->SetFlags(RF_Transient);
+	NewComponent->SetFlags(RF_TextExportTransient);
+	NewComponent->SetFlags(RF_DuplicateTransient);
+
+	NewComponent->SetMobility(EComponentMobility::Movable);
+	NewComponent->SetGenerateOverlapEvents(false);
+
+	NewComponent->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+	UpdatePreviewMeshCollisionState(NewComponent);
+
+	NewComponent->SetTangentsType(EDynamicMeshComponentTangentsMode::AutoCalculated);
+	//NewComponent->SetColorOverrideMode(EDynamicMeshComponentColorOverrideMode::VertexColors);
+
+	NewComponent->SetupAttachment(GetRootComponent());
+	NewComponent->RegisterComponent();
+	return NewComponent;
+}
+
+void AGSModelGridActor::ConfigurePreviewMeshMaterials(UDynamicMeshComponent* Component, const TArray<UMaterialInterface*>& Materials)
+{
+	if (Materials.Num() > 0)
+	{
+		Component->ConfigureMaterialSet(Materials);
+	}
+	else
+	{
+		UMaterial* GridMaterial = LoadObject<UMaterial>(nullptr, TEXT("/GradientspaceUEToolbox/Materials/M_GridEditMaterial"));
+		if (GridMaterial == nullptr)
+		{
+			GridMaterial = UMaterial::GetDefaultMaterial(MD_Surface);
+		}
+		Component->SetMaterial(0, GridMaterial);
+	}
+}
+
+
 void AGSModelGridActor::UpdateGridPreviewMesh(UE::Geometry::FDynamicMesh3&& PreviewMesh, TArray<UMaterialInterface*>&& Materials)
 {
 //#if WITH_EDITOR
@@ -177,52 +255,98 @@ void AGSModelGridActor::UpdateGridPreviewMesh(UE::Geometry::FDynamicMesh3&& Prev
 		return;
 	}
 
-	bool bWasCreatedThisFrame = false;
+	// switching from chunked to single-mesh mode
+	for (TPair<FIntPoint, TObjectPtr<UDynamicMeshComponent>>& Pair : PreviewChunkComponents)
+	{
+		if (Pair.Value != nullptr)
+			DestroyPreviewComponent(Pair.Value);
+	}
+	PreviewChunkComponents.Reset();
+
 	if (PreviewMeshComponent == nullptr)
 	{
-		PreviewMeshComponent = NewObject<UDynamicMeshComponent>(this, FName("TransientDynamicMesh") );
+		PreviewMeshComponent = CreatePreviewMeshComponent(FName("TransientDynamicMesh"));
+	}
 
-		// have to explicitly set these flags because the uproperty markup will not be transferred to this new object
-		// Note that this slows down PIE quite a bit...possibly should only use TextExportTransient?
-		PreviewMeshComponent->ClearFlags(RF_Transactional);
-		PreviewMeshComponent->SetFlags(RF_Transient);
-		PreviewMeshComponent->SetFlags(RF_TextExportTransient);
-		PreviewMeshComponent->SetFlags(RF_DuplicateTransient);
+	ConfigurePreviewMeshMaterials(PreviewMeshComponent, Materials);
+
+	PreviewMeshComponent->EditMesh([&](FDynamicMesh3& EditMesh)
+	{
+		EditMesh = MoveTemp(PreviewMesh);
+	}, EDynamicMeshComponentRenderUpdateMode::FullUpdate);
+
+	PreviewMeshComponent->UpdateCollision(true);
+}
 
-		PreviewMeshComponent->SetMobility(EComponentMobility::Movable);
-		PreviewMeshComponent->SetGenerateOverlapEvents(false);
 
-		PreviewMeshComponent->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
-		UpdatePreviewMeshCollisionState();
+void AGSModelGridActor::UpdateGridPreviewChunks(const TArray<FIntPoint>& Chunks, TArray<FDynamicMesh3>& ChunkMeshes,
+	bool bRemoveOtherChunks, const TArray<UMaterialInterface*>& Materials)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(AGSModelGridActor::UpdateGridPreviewChunks);
 
-		PreviewMeshComponent->SetTangentsType(EDynamicMeshComponentTangentsMode::AutoCalculated);
-		//PreviewMeshComponent->SetColorOverrideMode(EDynamicMeshComponentColorOverrideMode::VertexColors);
+	// see comment in UpdateGridPreviewMesh
+	if (this->GetWorld() == nullptr)
+		return;
 
-		PreviewMeshComponent->SetupAttachment(GetRootComponent());
-		PreviewMeshComponent->RegisterComponent();
-		bWasCreatedThisFrame = true;
+	if (bEnablePreviewMesh == false)
+	{
+		if (HasPreviewMeshComponents())
+			UpdatePreviewMeshState();
+		return;
 	}
 
-	if (Materials.Num() > 0)
+	// switching from single-mesh to chunked mode
+	if (PreviewMeshComponent != nullptr)
 	{
-		PreviewMeshComponent->ConfigureMaterialSet(Materials);
+		DestroyPreviewComponent(PreviewMeshComponent);
+		PreviewMeshComponent = nullptr;
 	}
-	else
+
+	if (bRemoveOtherChunks)
 	{
-		UMaterial* GridMaterial = LoadObject<UMaterial>(nullptr, TEXT("/GradientspaceUEToolbox/Materials/M_GridEditMaterial"));
-		if (GridMaterial == nullptr)
+		TSet<FIntPoint> KeepChunks(Chunks);
+		for (auto It = PreviewChunkComponents.CreateIterator(); It; ++It)
 		{
-			GridMaterial = UMaterial::GetDefaultMaterial(MD_Surface);
+			if (KeepChunks.Contains(It->Key) == false)
+			{
+				if (It->Value != nullptr)
+					DestroyPreviewComponent(It->Value);
+				It.RemoveCurrent();
+			}
 		}
-		PreviewMeshComponent->SetMaterial(0, GridMaterial);
 	}
 
-	PreviewMeshComponent->EditMesh([&](FDynamicMesh3& EditMesh)
+	check(Chunks.Num() == ChunkMeshes.Num());
+	for (int32 k = 0; k < Chunks.Num(); ++k)
 	{
-		EditMesh = MoveTemp(PreviewMesh);
-	}, EDynamicMeshComponentRenderUpdateMode::FullUpdate);
+		TObjectPtr<UDynamicMeshComponent>* Found = PreviewChunkComponents.Find(Chunks[k]);
+		UDynamicMeshComponent* ChunkComponent = (Found != nullptr) ? Found->Get() : nullptr;
 
-	PreviewMeshComponent->UpdateCollision(true);
+		// empty chunks do not need a component
+		if (ChunkMeshes[k].TriangleCount() == 0)
+		{
+			if (ChunkComponent != nullptr)
+			{
+				DestroyPreviewComponent(ChunkComponent);
+				PreviewChunkComponents.Remove(Chunks[k]);
+			}
+			continue;
+		}
+
+		if (ChunkComponent == nullptr)
+		{
+			ChunkComponent = CreatePreviewMeshComponent(MakeUniqueObjectName(this, UDynamicMeshComponent::StaticClass(), FName("TransientDynamicMeshChunk")));
+			PreviewChunkComponents.Add(Chunks[k], ChunkComponent);
+		}
+
+		ConfigurePreviewMeshMaterials(ChunkComponent, Materials);
+		ChunkComponent->EditMesh([&](FDynamicMesh3& EditMesh)
+		{
+			EditMesh = MoveTemp(ChunkMeshes[k]);
+		}, EDynamicMeshComponentRenderUpdateMode::FullUpdate);
+
+		ChunkComponent->UpdateCollision(true);
+	}
 }
 
 
@@ -231,26 +355,42 @@ void AGSModelGridActor::SetPreviewMeshCollisionMode(EModelGridMeshCollisionMode
 {
 	if (PreviewMeshCollisionMode != NewMode) {
 		PreviewMeshCollisionMode = NewMode;
-		if (PreviewMeshComponent) {
-			UpdatePreviewMeshCollisionState();
-			PreviewMeshComponent->UpdateCollision(true);
+		UpdateAllPreviewMeshCollision();
+	}
+}
+
+void AGSModelGridActor::UpdateAllPreviewMeshCollision()
+{
+	if (PreviewMeshComponent) {
+		UpdatePreviewMeshCollisionState(PreviewMeshComponent);
+		PreviewMeshComponent->UpdateCollision(true);
+	}
+	for (TPair<FIntPoint, TObjectPtr<UDynamicMeshComponent>>& Pair : PreviewChunkComponents) {
+		if (Pair.Value) {
+			UpdatePreviewMeshCollisionState(Pair.Value);
+			Pair.Value->UpdateCollision(true);
 		}
 	}
 }
 
 void AGSModelGridActor::UpdatePreviewMeshCollisionState()
 {
-	if (!PreviewMeshComponent) return;
+	UpdatePreviewMeshCollisionState(PreviewMeshComponent);
+}
+
+void AGSModelGridActor::UpdatePreviewMeshCollisionState(UDynamicMeshComponent* Component)
+{
+	if (!Component) return;
 
 	if (this->PreviewMeshCollisionMode == EModelGridMeshCollisionMode::ComplexAsSimple)
 	{
-		PreviewMeshComponent->CollisionType = ECollisionTraceFlag::CTF_UseComplexAsSimple;
-		PreviewMeshComponent->bEnableComplexCollision = true;
+		Component->CollisionType = ECollisionTraceFlag::CTF_UseComplexAsSimple;
+		Component->bEnableComplexCollision = true;
 	}
 	else
 	{
-		PreviewMeshComponent->CollisionType = ECollisionTraceFlag::CTF_UseDefault;
-		PreviewMeshComponent->bEnableComplexCollision = false;
+		Component->CollisionType = ECollisionTraceFlag::CTF_UseDefault;
+		Component->bEnableComplexCollision = false;
 	}
 }
 
@@ -271,10 +411,14 @@ static void BuildModelGridMesh(
 	// update mesh...
 	FDynamicMesh3 FinalMesh;
 
-	ModelGrid->ProcessGrid([&](const GS::ModelGrid& Grid)
+	// extract from a snapshot so that the grid is not locked during meshing. The snapshot is released
+	// as soon as the mesh is extracted, while it is alive any edit to the grid must copy it (copy-on-write)
+	TSharedPtr<const GS::ModelGrid> GridSnapshot = ModelGrid->GetGridSnapshot();
+	if (GridSnapshot.IsValid())
 	{
-		GS::ExtractGridFullMesh(Grid, FinalMesh, /*materials=*/true, /*uvs=*/true, GridMaterialMap);
-	});
+		GS::ExtractGridFullMesh(*GridSnapshot, FinalMesh, /*materials=*/true, /*uvs=*/true, GridMaterialMap);
+	}
+	GridSnapshot.Reset();
 
 	if (FinalMesh.TriangleCount() > 0)
 	{
@@ -291,34 +435,200 @@ static void BuildModelGridMesh(
 
 
 
-void AGSModelGridActor::OnModelGridChanged(UGSModelGridComponent* Component, UGSModelGrid* ModelGrid)
+void AGSModelGridActor::OnModelGridChanged(UGSModelGridComponent* Component, UGSModelGrid* ModelGrid, const FModelGridChangeJournal& ChangeJournal)
 {
-	UGSGridMaterialSet* MaterialSet = Component->GetGridMaterials();
+	PendingMeshChanges.Append(ChangeJournal);
+
+	// the in-flight job is now out-of-date, its completion will launch the rebuild
+	if (bMeshJobInFlight)
+	{
+		bMeshRebuildPending = true;
+		return;
+	}
+
+	LaunchMeshRebuildJob();
+}
+
+
+//! incremental mesher state for chunked preview mesh. Each mesh-cache column is a chunk.
+struct FModelGridActorChunkMesher
+{
+	FDynamicMesh3BuilderFactory BuilderFactory;
+	GS::ModelGridMeshCache MeshCache;
+};
+
+void AGSModelGridActor::LaunchMeshRebuildJob()
+{
+	if (bUseChunkedPreviewMesh)
+	{
+		LaunchChunkedMeshRebuildJob();
+		return;
+	}
+	PendingMeshChanges.Reset();
+
+	UGSModelGrid* ModelGrid = GetGrid();
+	UGSGridMaterialSet* MaterialSet = GetGridComponent()->GetGridMaterials();
 
 	struct FJobData
 	{
 		FDynamicMesh3 FinalMesh;
 		TArray<UMaterialInterface*> FinalMaterials;
-		// todo some kind of timestamp so that if we launch two jobs, we take later result?
 	};
 	TSharedPtr<FJobData> RebuildMeshData = MakeShared<FJobData>();
 
+	bMeshJobInFlight = true;
+	bMeshRebuildPending = false;
+
 	UGSJobSubsystem::EnqueueStandardJob(
 		this, this, 
 		[RebuildMeshData, MaterialSet, ModelGrid, this]() {
 			if (!ensure(IsValid(this)))
 				return false;
-
 			BuildModelGridMesh(ModelGrid, MaterialSet, RebuildMeshData->FinalMesh, RebuildMeshData->FinalMaterials);
 			return true;
 		},
 		[RebuildMeshData, this]()
 		{
-			if (ensure(IsValid(this)) )
-				this->UpdateGridPreviewMesh(MoveTemp(RebuildMeshData->FinalMesh), MoveTemp(RebuildMeshData->FinalMaterials));
+			if (!ensure(IsValid(this)))
+				return;
+
+			// always apply the finished mesh, even if the grid has been edited since the job launched.
+			// In that case bMeshRebuildPending is set and the follow-up rebuild will replace it, so that
+			// continuous edits still update the preview (otherwise every mesh could be discarded)
+			bMeshJobInFlight = false;
+			this->UpdateGridPreviewMesh(MoveTemp(RebuildMeshData->FinalMesh), MoveTemp(RebuildMeshData->FinalMaterials));
+
+			if (bMeshRebuildPending)
+				LaunchMeshRebuildJob();
 		},
 		UGSJobSubsystem::FJobOptions::ThreadSafe() );
+}
+
+
+void AGSModelGridActor::LaunchChunkedMeshRebuildJob()
+{
+	UGSModelGrid* ModelGrid = GetGrid();
+	UGSGridMaterialSet* MaterialSet = GetGridComponent()->GetGridMaterials();
 
+	struct FJobData
+	{
+		UGSModelGrid* ModelGrid = nullptr;
+		FModelGridChangeJournal Changes;
+		TSharedPtr<FModelGridActorChunkMesher, ESPMode::ThreadSafe> Mesher;
+		bool bFullRebuild = false;
+
+		TArray<FIntPoint> Chunks;
+		TArray<FDynamicMesh3> ChunkMeshes;
+		TArray<UMaterialInterface*> FinalMaterials;
+		uint32 PreviewGeneration = 0;
+	};
+	TSharedPtr<FJobData> JobData = MakeShared<FJobData>();
+	JobData->PreviewGeneration = PreviewGeneration;
+	JobData->ModelGrid = ModelGrid;
+	JobData->Changes = MoveTemp(PendingMeshChanges);
+	PendingMeshChanges.Reset();
+	// without a known modified region (or mesher) we have to re-mesh everything
+	JobData->bFullRebuild = (ChunkMesher.IsValid() == false) || JobData->Changes.IsFullGridChange() || JobData->Changes.bHasModifiedCells == false;
+	if (JobData->bFullRebuild == false)
+		JobData->Mesher = ChunkMesher;
+
+	bMeshJobInFlight = true;
+	bMeshRebuildPending = false;
+
+	UGSJobSubsystem::EnqueueStandardJob(
+		this, this,
+		[JobData, MaterialSet, this]() {
+			if (!ensure(IsValid(this)))
+				return false;
+			// The snapshot is taken when the job starts rather than at launch, so a queued job never holds
+			// an out-of-date snapshot (which would force a copy-on-write on every edit while it waits).
+			// The grid may include edits made after launch, those are also in PendingMeshChanges and the
+			// pending rebuild picks them up, so continuous edits still update the preview
+			TSharedPtr<const GS::ModelGrid> SourceGrid = (JobData->ModelGrid != nullptr) ? JobData->ModelGrid->GetGridSnapshot() : nullptr;
+			if (SourceGrid.IsValid() == false)
+				return true;
+			TRACE_CPUPROFILER_EVENT_SCOPE(AGSModelGridActor::ChunkedMeshJob);
+
+			const GS::ModelGrid& Grid = *SourceGrid;
+
+			GS::SharedPtr<FReferenceSetMaterialMap> GridMaterialMap = MakeSharedPtr<FReferenceSetMaterialMap>();
+			UGSGridMaterialSet::BuildMaterialMapForSet(MaterialSet, *GridMaterialMap);
+			JobData->FinalMaterials = GridMaterialMap->MaterialList;
+
+			AxisBox3i UpdateCellBounds;
+			if (JobData->bFullRebuild)
+			{
+				JobData->Mesher = MakeShared<FModelGridActorChunkMesher, ESPMode::ThreadSafe>();
+				JobData->Mesher->BuilderFactory.bEnableMaterials = true;
+				JobData->Mesher->BuilderFactory.bEnableUVs = true;
+				JobData->Mesher->MeshCache.Initialize(Grid.GetCellDimensions(), &JobData->Mesher->BuilderFactory);
+				// chunks are meshed independently, so faces on chunk borders must always be emitted
+				JobData->Mesher->MeshCache.bIncludeAllBlockBorderFaces = true;
+				UpdateCellBounds = Grid.GetModifiedRegionBounds(0);
+			}
+			else
+			{
+				// changing a cell can affect faces of neighbouring cells
+				const FIntVector One(1, 1, 1);
+				UpdateCellBounds = AxisBox3i((Vector3i)(JobData->Changes.ModifiedCellMin - One), (Vector3i)(JobData->Changes.ModifiedCellMax + One));
+			}
+			GS::ModelGridMeshCache& MeshCache = JobData->Mesher->MeshCache;
+			MeshCache.SetMaterialMap(GridMaterialMap);
+
+			AxisBox3d UpdateBox = Grid.GetCellLocalBounds(UpdateCellBounds.Min);
+			UpdateBox.Contain(Grid.GetCellLocalBounds(UpdateCellBounds.Max));
+			TArray<Vector2i> Columns;
+			MeshCache.UpdateInBounds(Grid, UpdateBox, [&](Vector2i Column) { Columns.Add(Column); });
+
+			// column meshes are extracted from the mesh cache, the grid is no longer needed
+			SourceGrid.Reset();
+
+			JobData->Chunks.SetNum(Columns.Num());
+			JobData->ChunkMeshes.SetNum(Columns.Num());
+			ParallelFor(Columns.Num(), [&](int32 Index)
+			{
+				JobData->Chunks[Index] = FIntPoint(Columns[Index].X, Columns[Index].Y);
+				FDynamicMesh3& ChunkMesh = JobData->ChunkMeshes[Index];
+				FDynamicMesh3Collector Collector(&ChunkMesh, true, true);
+				MeshCache.ExtractColumnMesh_Async(Columns[Index], Collector);
+
+				if (ChunkMesh.TriangleCount() > 0)
+				{
+					FMergeCoincidentMeshEdges Welder(&ChunkMesh);
+					Welder.MergeVertexTolerance = 0.01;
+					Welder.OnlyUniquePairs = false;
+					Welder.bWeldAttrsOnMergedEdges = true;
+					Welder.Apply();
+					ChunkMesh.CompactInPlace();
+				}
+			});
+
+			return true;
+		},
+		[JobData, this]()
+		{
+			if (!ensure(IsValid(this)))
+				return;
+
+			bMeshJobInFlight = false;
+			if (JobData->PreviewGeneration != PreviewGeneration || JobData->Mesher.IsValid() == false)
+			{
+				// preview components were destroyed while the job was running, so the mesher and chunks 
+				// no longer match the components. PendingMeshChanges already contains a full-grid change.
+				if (bEnablePreviewMesh)
+					bMeshRebuildPending = true;
+			}
+			else
+			{
+				// mesh cache has been updated, so the result must be applied even if it is out-of-date
+				ChunkMesher = JobData->Mesher;
+				this->UpdateGridPreviewChunks(JobData->Chunks, JobData->ChunkMeshes, JobData->bFullRebuild, JobData->FinalMaterials);
+			}
+
+			if (bMeshRebuildPending)
+				LaunchMeshRebuildJob();
+		},
+		UGSJobSubsystem::FJobOptions::ThreadSafe() );
 }
 
 
@@ -0,0 +1,106 @@
+// Copyright Gradientspace Corp. All Rights Reserved.
+#include "GridActor/ModelGridCellDeltas.h"
+#include "GridActor/UGSModelGrid.h"
+
+#include "Templates/TypeHash.h"
+#include "Misc/Crc.h"
+
+using namespace GS;
+
+// field-wise comparison, a bitwise comparison of the struct would include padding bytes.
+// GridMaterial is a single packed value, so it can be compared bitwise.
+bool GS::IsSameModelGridCell(const ModelGridCell& A, const ModelGridCell& B)
+{
+	return A.CellType == B.CellType
+		&& A.CellData == B.CellData
+		&& A.MaterialType == B.MaterialType
+		&& FMemory::Memcmp(&A.CellMaterial, &B.CellMaterial, sizeof(A.CellMaterial)) == 0;
+}
+
+// hash of the same fields as IsSameModelGridCell
+static uint32 GetModelGridCellHash(const ModelGridCell& Cell)
+{
+	uint32 Hash = HashCombine(::GetTypeHash((uint32)Cell.CellType), ::GetTypeHash((uint32)Cell.MaterialType));
+	Hash = FCrc::MemCrc32(&Cell.CellData, sizeof(Cell.CellData), Hash);
+	return FCrc::MemCrc32(&Cell.CellMaterial, sizeof(Cell.CellMaterial), Hash);
+}
+
+
+void GS::FCompressedModelGridCellDeltas::Compress(TArray<FModelGridCellDelta>& Deltas)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCompressedModelGridCellDeltas::Compress);
+	const int32 BlockSize = FModelGridChangeJournal::BlockSize;
+
+	auto GetLocalIndex = [BlockSize](const FIntVector& CellIndex, const FIntVector& BlockIndex) {
+		FIntVector Local = CellIndex - BlockIndex * BlockSize;
+		return (uint16)(Local.X + BlockSize * (Local.Y + BlockSize * Local.Z));
+	};
+	// sort by block, and then by local index inside the block
+	Deltas.Sort([&](const FModelGridCellDelta& A, const FModelGridCellDelta& B)
+	{
+		FIntVector CellA(A.CellIndex.X, A.CellIndex.Y, A.CellIndex.Z), CellB(B.CellIndex.X, B.CellIndex.Y, B.CellIndex.Z);
+		FIntVector BlockA = FModelGridChangeJournal::GetBlockIndex(CellA), BlockB = FModelGridChangeJournal::GetBlockIndex(CellB);
+		if (BlockA.Z != BlockB.Z) return BlockA.Z < BlockB.Z;
+		if (BlockA.Y != BlockB.Y) return BlockA.Y < BlockB.Y;
+		if (BlockA.X != BlockB.X) return BlockA.X < BlockB.X;
+		return GetLocalIndex(CellA, BlockA) < GetLocalIndex(CellB, BlockB);
+	});
+
+	// palette lookup by hash, hash collisions just add a duplicate entry
+	TMap<uint32, int32> PaletteLookup;
+	auto GetPaletteIndex = [&](const ModelGridCell& Cell) -> int32
+	{
+		uint32 Hash = GetModelGridCellHash(Cell);
+		if (const int32* Found = PaletteLookup.Find(Hash)) {
+			if (IsSameModelGridCell(CellPalette[*Found], Cell))
+				return *Found;
+			return CellPalette.Add(Cell);
+		}
+		int32 NewIndex = CellPalette.Add(Cell);
+		PaletteLookup.Add(Hash, NewIndex);
+		return NewIndex;
+	};
+
+	for (const FModelGridCellDelta& Delta : Deltas)
+	{
+		FIntVector CellIndex(Delta.CellIndex.X, Delta.CellIndex.Y, Delta.CellIndex.Z);
+		FIntVector BlockIndex = FModelGridChangeJournal::GetBlockIndex(CellIndex);
+		uint16 LocalIndex = GetLocalIndex(CellIndex, BlockIndex);
+		int32 BeforeCell = GetPaletteIndex(Delta.Before), AfterCell = GetPaletteIndex(Delta.After);
+
+		if (Blocks.Num() == 0 || Blocks.Last().BlockIndex != BlockIndex)
+			Blocks.Add(FBlock{ BlockIndex });
+		TArray<FRun>& Runs = Blocks.Last().Runs;
+		if (Runs.Num() > 0) {
+			FRun& LastRun = Runs.Last();
+			if (LastRun.StartIndex + LastRun.Count == LocalIndex && LastRun.BeforeCell == BeforeCell && LastRun.AfterCell == AfterCell) {
+				LastRun.Count++;
+				continue;
+			}
+		}
+		Runs.Add(FRun{ LocalIndex, 1, BeforeCell, AfterCell });
+	}
+
+	for (FBlock& Block : Blocks)
+		Block.Runs.Shrink();
+	CellPalette.Shrink();
+}
+
+void GS::FCompressedModelGridCellDeltas::EnumerateDeltas(TFunctionRef<void(const Vector3i& CellIndex, const ModelGridCell& Before, const ModelGridCell& After)> DeltaFunc) const
+{
+	const int32 BlockSize = FModelGridChangeJournal::BlockSize;
+	for (const FBlock& Block : Blocks)
+	{
+		FIntVector BlockOrigin = Block.BlockIndex * BlockSize;
+		for (const FRun& Run : Block.Runs)
+		{
+			const ModelGridCell& Before = CellPalette[Run.BeforeCell];
+			const ModelGridCell& After = CellPalette[Run.AfterCell];
+			for (int32 k = Run.StartIndex; k < Run.StartIndex + Run.Count; ++k)
+			{
+				Vector3i CellIndex(BlockOrigin.X + k % BlockSize, BlockOrigin.Y + (k / BlockSize) % BlockSize, BlockOrigin.Z + k / (BlockSize * BlockSize));
+				DeltaFunc(CellIndex, Before, After);
+			}
+		}
+	}
+}
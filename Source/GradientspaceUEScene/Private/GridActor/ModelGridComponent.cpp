@@ -5,6 +5,7 @@
 #include "Engine/CollisionProfile.h"
 #include "ModelGrid/ModelGrid.h"
 #include "ModelGrid/ModelGridCollision.h"
+#include "GSJobSubsystem.h"
 
 
 UGSModelGridComponent::UGSModelGridComponent(const FObjectInitializer& ObjectInitializer)
@@ -64,6 +65,13 @@ void UGSModelGridComponent::PostEditImport()
 	ForceUpdateConnections();
 }
 
+void UGSModelGridComponent::BeginDestroy()
+{
+	// discard any in-flight collider jobs
+	ColliderUpdateRevision++;
+	Super::BeginDestroy();
+}
+
 #if WITH_EDITOR
 void UGSModelGridComponent::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
@@ -132,31 +140,30 @@ UGSGridMaterialSet* UGSModelGridComponent::GetGridMaterials() const
 	return LocalModelGridMaterials;
 }
 
-void UGSModelGridComponent::OnLocalModelGridUpdated(UGSModelGrid* ModelGrid)
+void UGSModelGridComponent::OnLocalModelGridUpdated(UGSModelGrid* ModelGrid, const FModelGridChangeJournal& ChangeJournal)
 {
 	check(ModelGrid == LocalModelGrid);
 	if (GetGridAssetIfEnabled() == nullptr)
 	{
-		NotifyModelGridModification(ModelGrid);
+		NotifyModelGridModification(ModelGrid, ChangeJournal);
 	}
 }
 
-void UGSModelGridComponent::OnModelGridAssetUpdated(UGSModelGrid* ModelGrid)
+void UGSModelGridComponent::OnModelGridAssetUpdated(UGSModelGrid* ModelGrid, const FModelGridChangeJournal& ChangeJournal)
 {
 	check(ModelGrid == GridObjectAsset->ModelGrid);
 	if (GetGridAssetIfEnabled()) 
 	{
-		NotifyModelGridModification(ModelGrid);
+		NotifyModelGridModification(ModelGrid, ChangeJournal);
 	}
 }
 
-void UGSModelGridComponent::NotifyModelGridModification(UGSModelGrid* ModelGrid)
+void UGSModelGridComponent::NotifyModelGridModification(UGSModelGrid* ModelGrid, const FModelGridChangeJournal& ChangeJournal)
 {
-	// force-wait for collider update, for now
-	InvalidateGridCollider();
-	UpdateGridCollider();
+	// previous collider remains active until the update job completes
+	LaunchGridColliderUpdate(ChangeJournal);
 
-	ModelGridChangedEvent.Broadcast(this, ModelGrid);
+	ModelGridChangedEvent.Broadcast(this, ModelGrid, ChangeJournal);
 }
 
 
@@ -189,38 +196,182 @@ bool UGSModelGridComponent::UpdateGridAssetListener()
 
 void UGSModelGridComponent::NotifyCurrentActiveGridModified()
 {
+	// active grid may have been swapped, so listeners must treat this as a full-grid change
 	if (GetGridAssetIfEnabled())
 	{
-		OnModelGridAssetUpdated(GridObjectAsset->ModelGrid);
+		OnModelGridAssetUpdated(GridObjectAsset->ModelGrid, FModelGridChangeJournal::MakeFullGridChange());
 	}
 	else
 	{
-		OnLocalModelGridUpdated(LocalModelGrid);
+		OnLocalModelGridUpdated(LocalModelGrid, FModelGridChangeJournal::MakeFullGridChange());
 	}
-
-	InvalidateGridCollider();
-	UpdateGridCollider();
 }
 
 
 void UGSModelGridComponent::InvalidateGridCollider()
 {
+	// an in-flight job is not published, as its revision is now out of date
+	PublishedColliderRevision = ++ColliderUpdateRevision;
 	GridCollider.Reset();
+	PendingColliderChanges.Reset();
+	bColliderUpdatePending = false;
+	BackGridCollider.Reset();
+	BackGridColliderChanges.Reset();
 }
 
 void UGSModelGridComponent::UpdateGridCollider()
 {
 	if (GridCollisionMode == EModelGridComponentCollisionMode::GridCollider)
 	{
-		GridCollider = MakePimpl<GS::ModelGridCollider>();
+		TRACE_CPUPROFILER_EVENT_SCOPE(UGSModelGridComponent::UpdateGridCollider);
+
+		PublishedColliderRevision = ++ColliderUpdateRevision;
+		PendingColliderChanges.Reset();
+		bColliderUpdatePending = false;
+		BackGridCollider.Reset();
+		BackGridColliderChanges.Reset();
+
+		TSharedPtr<GS::ModelGridCollider, ESPMode::ThreadSafe> NewCollider = MakeShared<GS::ModelGridCollider, ESPMode::ThreadSafe>();
 		GetGrid()->ProcessGrid([&](const GS::ModelGrid& Grid) {
-			GridCollider->Initialize(Grid);
+			NewCollider->Initialize(Grid);
 			GS::AxisBox3i ModifiedCellBounds = Grid.GetModifiedRegionBounds(0);
 			GS::AxisBox3d UpdateBox = Grid.GetCellLocalBounds(ModifiedCellBounds.Min);
 			UpdateBox.Contain(Grid.GetCellLocalBounds(ModifiedCellBounds.Max));
-			GridCollider->UpdateInBounds(Grid, UpdateBox);
+			NewCollider->UpdateInBounds(Grid, UpdateBox);
 		});
+		GridCollider = NewCollider;
+	}
+}
+
+void UGSModelGridComponent::LaunchGridColliderUpdate(const FModelGridChangeJournal& ChangeJournal)
+{
+	UGSModelGrid* ActiveGrid = GetGrid();
+	if (GridCollisionMode != EModelGridComponentCollisionMode::GridCollider || ActiveGrid == nullptr)
+	{
+		InvalidateGridCollider();
+		return;
+	}
+
+	// changes accumulate until the next job is launched
+	PendingColliderChanges.Append(ChangeJournal);
+	++ColliderUpdateRevision;
+
+	if (bColliderJobInFlight)
+	{
+		bColliderUpdatePending = true;
+		return;
+	}
+	LaunchGridColliderJob();
+}
+
+void UGSModelGridComponent::LaunchGridColliderJob()
+{
+	UGSModelGrid* ActiveGrid = GetGrid();
+	if (ActiveGrid == nullptr)
+		return;
+
+	struct FColliderJob
+	{
+		UGSModelGrid* ModelGrid = nullptr;
+		//! collider to update in place (either a copy of GridCollider or BackGridCollider), or null for a full rebuild
+		TSharedPtr<GS::ModelGridCollider, ESPMode::ThreadSafe> NewCollider;
+		bool bCopyPublishedCollider = false;
+		TSharedPtr<GS::ModelGridCollider, ESPMode::ThreadSafe> PublishedCollider;
+		//! changes relative to the published collider
+		FModelGridChangeJournal Changes;
+		//! changes that must be applied to NewCollider
+		FModelGridChangeJournal UpdateChanges;
+		int64 Revision = 0;
+	};
+	TSharedPtr<FColliderJob> JobData = MakeShared<FColliderJob>();
+	JobData->ModelGrid = ActiveGrid;
+	JobData->Revision = ColliderUpdateRevision;
+	JobData->Changes = MoveTemp(PendingColliderChanges);
+	PendingColliderChanges.Reset();
+
+	// incremental update is only possible if we know where the grid changed
+	if (GridCollider.IsValid() && JobData->Changes.IsFullGridChange() == false && JobData->Changes.bHasModifiedCells)
+	{
+		// reuse the back collider if nothing else references it, it only needs the changes it has not seen yet
+		if (BackGridCollider.IsValid() && BackGridCollider.GetSharedReferenceCount() == 1 && BackGridColliderChanges.IsFullGridChange() == false)
+		{
+			JobData->NewCollider = MoveTemp(BackGridCollider);
+			JobData->UpdateChanges = MoveTemp(BackGridColliderChanges);
+			JobData->UpdateChanges.Append(JobData->Changes);
+		}
+		else
+		{
+			JobData->bCopyPublishedCollider = true;
+			JobData->PublishedCollider = GridCollider;
+			JobData->UpdateChanges = JobData->Changes;
+		}
 	}
+	BackGridCollider.Reset();
+	BackGridColliderChanges.Reset();
+
+	bColliderJobInFlight = true;
+	bColliderUpdatePending = false;
+
+	UGSJobSubsystem::EnqueueStandardJob(
+		this, this,
+		[JobData]() {
+			// The snapshot is taken when the job starts, so a queued job does not hold an out-of-date snapshot
+			// that would force a copy-on-write on each edit. Edits made after launch are in PendingColliderChanges.
+			// Always return true, the game thread func must run to clear bColliderJobInFlight
+			TSharedPtr<const GS::ModelGrid> SourceGrid = (JobData->ModelGrid != nullptr) ? JobData->ModelGrid->GetGridSnapshot() : nullptr;
+			if (SourceGrid.IsValid() == false)
+				return true;
+			TRACE_CPUPROFILER_EVENT_SCOPE(UGSModelGridComponent::ColliderUpdateJob);
+
+			const GS::ModelGrid& Grid = *SourceGrid;
+			GS::AxisBox3i UpdateCellBounds;
+			if (JobData->NewCollider.IsValid() || JobData->bCopyPublishedCollider)
+			{
+				if (JobData->bCopyPublishedCollider)
+				{
+					TRACE_CPUPROFILER_EVENT_SCOPE(UGSModelGridComponent::CopyCollider);
+					JobData->NewCollider = MakeShared<GS::ModelGridCollider, ESPMode::ThreadSafe>(*JobData->PublishedCollider);
+					JobData->PublishedCollider.Reset();
+				}
+				// Modified cells are expanded by one, as a cell change can affect neighbouring faces.
+				const FIntVector One(1, 1, 1);
+				UpdateCellBounds = GS::AxisBox3i((GS::Vector3i)(JobData->UpdateChanges.ModifiedCellMin - One), (GS::Vector3i)(JobData->UpdateChanges.ModifiedCellMax + One));
+			}
+			else
+			{
+				JobData->NewCollider = MakeShared<GS::ModelGridCollider, ESPMode::ThreadSafe>();
+				JobData->NewCollider->Initialize(Grid);
+				UpdateCellBounds = Grid.GetModifiedRegionBounds(0);
+			}
+			GS::AxisBox3d UpdateBox = Grid.GetCellLocalBounds(UpdateCellBounds.Min);
+			UpdateBox.Contain(Grid.GetCellLocalBounds(UpdateCellBounds.Max));
+			JobData->NewCollider->UpdateInBounds(Grid, UpdateBox);
+			return true;
+		},
+		[JobData, this]()
+		{
+			bColliderJobInFlight = false;
+
+			// publish if no full rebuild or invalidation has happened since the job was launched, even if 
+			// more changes are pending. The previous collider becomes the back collider for the next update.
+			if (JobData->Revision > PublishedColliderRevision && JobData->NewCollider.IsValid())
+			{
+				BackGridCollider = MoveTemp(GridCollider);
+				BackGridColliderChanges = MoveTemp(JobData->Changes);
+				GridCollider = MoveTemp(JobData->NewCollider);
+				PublishedColliderRevision = JobData->Revision;
+			}
+			else if (JobData->Revision > PublishedColliderRevision)
+			{
+				// job did not produce a collider, its changes must go into the next job (launched by the next change)
+				JobData->Changes.Append(PendingColliderChanges);
+				PendingColliderChanges = MoveTemp(JobData->Changes);
+			}
+
+			if (bColliderUpdatePending && GridCollisionMode == EModelGridComponentCollisionMode::GridCollider)
+				LaunchGridColliderJob();
+		},
+		UGSJobSubsystem::FJobOptions::ThreadSafe());
 }
 
 void UGSModelGridComponent::SetGridCollisionMode(EModelGridComponentCollisionMode NewMode)
@@ -234,8 +385,10 @@ void UGSModelGridComponent::SetGridCollisionMode(EModelGridComponentCollisionMod
 
 void UGSModelGridComponent::ProcessGridCollider(TFunctionRef<void(const GS::ModelGridCollider&)> ProcessFunc) const
 {
-	if (GridCollisionMode == EModelGridComponentCollisionMode::GridCollider && GridCollider.IsValid())
+	// hold a reference, GridCollider may be replaced by an update job during ProcessFunc
+	TSharedPtr<GS::ModelGridCollider, ESPMode::ThreadSafe> Collider = GridCollider;
+	if (GridCollisionMode == EModelGridComponentCollisionMode::GridCollider && Collider.IsValid())
 	{
-		ProcessFunc(*GridCollider);
+		ProcessFunc(*Collider);
 	}
 }
\ No newline at end of file
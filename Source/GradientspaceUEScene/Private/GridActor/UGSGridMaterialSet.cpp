@@ -73,11 +73,9 @@ void UGSGridMaterialSet::SetDefaultMaterial(UMaterialInterface* Material, FStrin
 
 FGSGridMaterialID UGSGridMaterialSet::FindOrAddExternalMaterial(UMaterialInterface* Material)
 {
-	for (FGSGridExternalMaterial& Mat : ExternalMaterials)
-	{
-		if (Mat.Material == Material)
-			return Mat.MaterialID;
-	}
+	int32 FoundIndex = FindExternalMaterialIndex(Material);
+	if (FoundIndex >= 0)
+		return ExternalMaterials[FoundIndex].MaterialID;
 
 	uint32 NewID = ReferenceSet.RegisterExternalMaterial((uint64_t)Material);
 	GS::MaterialReferenceID RefID(NewID);
@@ -86,7 +84,9 @@ FGSGridMaterialID UGSGridMaterialSet::FindOrAddExternalMaterial(UMaterialInterfa
 	NewMat.MaterialID.ReferenceType = (int32)RefID.MaterialType;
 	NewMat.MaterialID.Index = (int32)RefID.Index;
 	NewMat.Material = Material;
-	ExternalMaterials.Add(NewMat);
+	int32 NewIndex = ExternalMaterials.Add(NewMat);
+	AddToMaterialIndexMaps(NewIndex);
+	IndexedMaterialCount = ExternalMaterials.Num();
 
 	return NewMat.MaterialID;
 }
@@ -95,12 +95,66 @@ FGSGridMaterialID UGSGridMaterialSet::FindOrAddExternalMaterial(UMaterialInterfa
 
 UMaterialInterface* UGSGridMaterialSet::FindExternalMaterial(FGSGridMaterialID GridMaterialID)
 {
-	for (FGSGridExternalMaterial& Mat : ExternalMaterials)
-	{
-		if (Mat.MaterialID == GridMaterialID)
-			return Mat.Material;
-	}
-	return nullptr;
+	int32 FoundIndex = FindExternalMaterialIndex(GridMaterialID);
+	return (FoundIndex >= 0) ? ExternalMaterials[FoundIndex].Material : nullptr;
+}
+
+
+int32 UGSGridMaterialSet::FindExternalMaterialIndex(const UMaterialInterface* Material)
+{
+	if (IndexedMaterialCount != ExternalMaterials.Num())
+		UpdateMaterialIndexMaps();
+
+	const int32* Found = MaterialToIndexMap.Find(Material);
+	if (Found == nullptr)
+		return -1;		// maps are up-to-date, so this is a real miss
+	if (ExternalMaterials.IsValidIndex(*Found) && ExternalMaterials[*Found].Material == Material)
+		return *Found;
+
+	// entry was modified in-place (eg from BP), rebuild and try again
+	UpdateMaterialIndexMaps();
+	Found = MaterialToIndexMap.Find(Material);
+	return (Found != nullptr) ? *Found : -1;
+}
+
+
+int32 UGSGridMaterialSet::FindExternalMaterialIndex(FGSGridMaterialID GridMaterialID)
+{
+	if (IndexedMaterialCount != ExternalMaterials.Num())
+		UpdateMaterialIndexMaps();
+
+	const int32* Found = MaterialIDToIndexMap.Find(GridMaterialID);
+	if (Found == nullptr)
+		return -1;
+	if (ExternalMaterials.IsValidIndex(*Found) && ExternalMaterials[*Found].MaterialID == GridMaterialID)
+		return *Found;
+
+	UpdateMaterialIndexMaps();
+	Found = MaterialIDToIndexMap.Find(GridMaterialID);
+	return (Found != nullptr) ? *Found : -1;
+}
+
+
+void UGSGridMaterialSet::AddToMaterialIndexMaps(int32 Index)
+{
+	// keep the first entry for duplicates, to match a linear search
+	const FGSGridExternalMaterial& Mat = ExternalMaterials[Index];
+	if (MaterialToIndexMap.Contains(Mat.Material) == false)
+		MaterialToIndexMap.Add(Mat.Material, Index);
+	if (MaterialIDToIndexMap.Contains(Mat.MaterialID) == false)
+		MaterialIDToIndexMap.Add(Mat.MaterialID, Index);
+}
+
+
+void UGSGridMaterialSet::UpdateMaterialIndexMaps()
+{
+	MaterialToIndexMap.Reset();
+	MaterialIDToIndexMap.Reset();
+	MaterialToIndexMap.Reserve(ExternalMaterials.Num());
+	MaterialIDToIndexMap.Reserve(ExternalMaterials.Num());
+	for (int32 k = 0; k < ExternalMaterials.Num(); ++k)
+		AddToMaterialIndexMaps(k);
+	IndexedMaterialCount = ExternalMaterials.Num();
 }
 
 
@@ -167,6 +221,8 @@ void UGSGridMaterialSet::UpdateReferenceSet()
 			ExternalMaterial.MaterialID.Index = (int32)RefID.Index;
 		}
 	}
+
+	UpdateMaterialIndexMaps();
 }
 
 
@@ -1,15 +1,99 @@
 // Copyright Gradientspace Corp. All Rights Reserved.
 #include "GridActor/UGSModelGrid.h"
+#include "GridActor/ModelGridCellDeltas.h"
 
 #include "ModelGrid/ModelGrid.h"
 #include "ModelGrid/ModelGridSerializer.h"
+#include "ModelGrid/ModelGridEditor.h"
 #include "GradientspaceUELogging.h"
 
 #include "Templates/TypeHash.h"
+#include "Misc/ScopeExit.h"
+#include "Misc/Compression.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Change.h"
+#include "Misc/ITransaction.h"
+#include "Misc/Base64.h"
+#include "Grid/GSGridUtil.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
 
 
 using namespace UE::Geometry;
 
+static void ContainModifiedCellBounds(FModelGridChangeJournal& Journal, const FIntVector& MinCell, const FIntVector& MaxCell)
+{
+	if (Journal.bHasModifiedCells) {
+		Journal.ModifiedCellMin = FIntVector(FMath::Min(Journal.ModifiedCellMin.X, MinCell.X), FMath::Min(Journal.ModifiedCellMin.Y, MinCell.Y), FMath::Min(Journal.ModifiedCellMin.Z, MinCell.Z));
+		Journal.ModifiedCellMax = FIntVector(FMath::Max(Journal.ModifiedCellMax.X, MaxCell.X), FMath::Max(Journal.ModifiedCellMax.Y, MaxCell.Y), FMath::Max(Journal.ModifiedCellMax.Z, MaxCell.Z));
+	} else {
+		Journal.ModifiedCellMin = MinCell;
+		Journal.ModifiedCellMax = MaxCell;
+		Journal.bHasModifiedCells = true;
+	}
+}
+
+void FModelGridChangeJournal::AddModifiedCells(const FIntVector& MinCell, const FIntVector& MaxCell)
+{
+	ContainModifiedCellBounds(*this, MinCell, MaxCell);
+
+	if (bBlocksOverflowed)
+		return;
+	FIntVector MinBlock = GetBlockIndex(MinCell), MaxBlock = GetBlockIndex(MaxCell);
+	int64 NumNewBlocks = (int64)(MaxBlock.X - MinBlock.X + 1) * (int64)(MaxBlock.Y - MinBlock.Y + 1) * (int64)(MaxBlock.Z - MinBlock.Z + 1);
+	if (NumNewBlocks + ModifiedBlocks.Num() > MaxTrackedBlocks) {
+		ModifiedBlocks.Empty();
+		bBlocksOverflowed = true;
+		return;
+	}
+	for (int32 z = MinBlock.Z; z <= MaxBlock.Z; ++z)
+		for (int32 y = MinBlock.Y; y <= MaxBlock.Y; ++y)
+			for (int32 x = MinBlock.X; x <= MaxBlock.X; ++x)
+				ModifiedBlocks.Add(FIntVector(x, y, z));
+}
+
+void FModelGridChangeJournal::AddFullGridChange()
+{
+	bFullGridChanged = true;
+}
+
+void FModelGridChangeJournal::Append(const FModelGridChangeJournal& OtherJournal)
+{
+	bFullGridChanged = bFullGridChanged || OtherJournal.bFullGridChanged;
+	if (OtherJournal.bHasModifiedCells == false)
+		return;
+
+	ContainModifiedCellBounds(*this, OtherJournal.ModifiedCellMin, OtherJournal.ModifiedCellMax);
+
+	if (bBlocksOverflowed || OtherJournal.bBlocksOverflowed
+		|| ModifiedBlocks.Num() + OtherJournal.ModifiedBlocks.Num() > MaxTrackedBlocks)
+	{
+		ModifiedBlocks.Empty();
+		bBlocksOverflowed = true;
+	}
+	else
+		ModifiedBlocks.Append(OtherJournal.ModifiedBlocks);
+}
+
+void FModelGridChangeJournal::Reset()
+{
+	*this = FModelGridChangeJournal();
+}
+
+FIntVector FModelGridChangeJournal::GetBlockIndex(const FIntVector& CellIndex)
+{
+	auto FloorDiv = [](int32 Value) { return (Value >= 0) ? (Value / BlockSize) : ((Value - BlockSize + 1) / BlockSize); };
+	return FIntVector(FloorDiv(CellIndex.X), FloorDiv(CellIndex.Y), FloorDiv(CellIndex.Z));
+}
+
+FModelGridChangeJournal FModelGridChangeJournal::MakeFullGridChange()
+{
+	FModelGridChangeJournal Journal;
+	Journal.AddFullGridChange();
+	return Journal;
+}
+
+
 UGSModelGrid::UGSModelGrid(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -30,77 +114,250 @@ void UGSModelGrid::SetEnableTransactions(bool bEnable)
 	}
 }
 
+void UGSModelGrid::SetUseDeltaTransactions(bool bEnable)
+{
+	bUseDeltaTransactions = bEnable;
+}
+
+
+namespace GS
+{
+// Grid locks currently held by this thread. Used to allow nested ProcessGrid/EditGrid
+// calls on the same UGSModelGrid, which would otherwise self-deadlock on the FRWLock
+struct FHeldGridLock
+{
+	const UGSModelGrid* Grid = nullptr;
+	bool bWriteLock = false;
+};
+static thread_local TArray<FHeldGridLock, TInlineAllocator<4>> ThreadHeldGridLocks;
+
+static FHeldGridLock* FindThreadHeldGridLock(const UGSModelGrid* Grid)
+{
+	for (FHeldGridLock& HeldLock : ThreadHeldGridLocks) {
+		if (HeldLock.Grid == Grid)
+			return &HeldLock;
+	}
+	return nullptr;
+}
+}
+
+UGSModelGrid::EGridLockResult UGSModelGrid::AcquireGridLock(bool bWriteLock)
+{
+	if (GS::FHeldGridLock* HeldLock = GS::FindThreadHeldGridLock(this))
+	{
+		if (bWriteLock == false || HeldLock->bWriteLock)
+			return EGridLockResult::AlreadyHeld;
+
+		// EditGrid called from inside ProcessGrid on the same thread. Readers on other threads
+		// must be drained before we can write, so drop the read lock and take the write lock.
+		ensureMsgf(false, TEXT("UGSModelGrid::EditGrid called inside ProcessGrid on the same grid. Upgrading to write lock, the const Grid reference may be modified!"));
+		GridLock.ReadUnlock();
+		GridLock.WriteLock();
+		HeldLock->bWriteLock = true;
+		return EGridLockResult::UpgradedFromRead;
+	}
+
+	if (bWriteLock)
+		GridLock.WriteLock();
+	else
+		GridLock.ReadLock();
+	GS::ThreadHeldGridLocks.Add(GS::FHeldGridLock{ this, bWriteLock });
+	return EGridLockResult::Acquired;
+}
+
+void UGSModelGrid::ReleaseGridLock(EGridLockResult LockResult, bool bWriteLock)
+{
+	if (LockResult == EGridLockResult::AlreadyHeld)
+		return;
+
+	if (LockResult == EGridLockResult::UpgradedFromRead)
+	{
+		GS::FindThreadHeldGridLock(this)->bWriteLock = false;
+		GridLock.WriteUnlock();
+		GridLock.ReadLock();
+		return;
+	}
+
+	for (int32 k = GS::ThreadHeldGridLocks.Num() - 1; k >= 0; --k) {
+		if (GS::ThreadHeldGridLocks[k].Grid == this) {
+			GS::ThreadHeldGridLocks.RemoveAtSwap(k);
+			break;
+		}
+	}
+	if (bWriteLock)
+		GridLock.WriteUnlock();
+	else
+		GridLock.ReadUnlock();
+}
+
+
 void UGSModelGrid::InitializeNewGrid(bool bBroadcastEvents)
 {
-	GridLock.Lock();
+	EGridLockResult LockResult = AcquireGridLock(true);
 
 	FVector3d CellDimensions(50, 50, 50);
-	Grid = MakePimpl<GS::ModelGrid>();
+	Grid = MakeShared<GS::ModelGrid>();
 	Grid->Initialize(CellDimensions);
 
-	GridLock.Unlock();
+	ReleaseGridLock(LockResult, true);
 
 	if (bBroadcastEvents)
 	{
-		ModelGridReplacedEvent.Broadcast(this);
+		BroadcastGridChanged(true);
 	}
 }
 
 void UGSModelGrid::ProcessGrid(TFunctionRef<void(const GS::ModelGrid& Grid)> ProcessFunc)
 {
-	// TODO support multiple read-only locks?
-	GridLock.Lock();
+	// shared lock, multiple readers can process the grid concurrently
+	EGridLockResult LockResult = AcquireGridLock(false);
 
 	if (Grid)
 	{
 		ProcessFunc(*Grid);
 	}
 
-	GridLock.Unlock();
+	ReleaseGridLock(LockResult, false);
 }
 
 void UGSModelGrid::EditGrid(TFunctionRef<void(GS::ModelGrid& Grid)> EditFunc,
 	bool bDeferUpdateNotification)
 {
-	EditGridInternal(EditFunc);
+	EditGridWithNotification(EditFunc, nullptr, nullptr, bDeferUpdateNotification);
+}
+void UGSModelGrid::EditGridRegion(const FIntVector& MinCell, const FIntVector& MaxCell,
+	TFunctionRef<void(GS::ModelGrid& Grid)> EditFunc,
+	bool bDeferUpdateNotification)
+{
+	EditGridWithNotification(EditFunc, &MinCell, &MaxCell, bDeferUpdateNotification);
+}
+void UGSModelGrid::EditGridWithNotification(TFunctionRef<void(GS::ModelGrid& Grid)> EditFunc,
+	const FIntVector* ModifiedCellMin, const FIntVector* ModifiedCellMax, bool bDeferUpdateNotification)
+{
+	// a standalone EditGrid is its own undo transaction, otherwise the outer EndGridEdits records it
+	bool bRecordDelta = (GridEditStackDepth == 0) && (DeltaTransaction.IsValid() == false) && ShouldRecordDeltaTransaction();
+	if (bRecordDelta)
+		BeginDeltaTransaction();
+
+	EditGridInternal(EditFunc, ModifiedCellMin, ModifiedCellMax);
+
+	if (bRecordDelta)
+		EndDeltaTransaction();
+
 	if (GridEditStackDepth == 0 && bDeferUpdateNotification == false)
-		ModelGridReplacedEvent.Broadcast(this);
+		BroadcastGridChanged();
 }
-void UGSModelGrid::EditGridInternal(TFunctionRef<void(GS::ModelGrid& Grid)> EditFunc)
+void UGSModelGrid::EditGridInternal(TFunctionRef<void(GS::ModelGrid& Grid)> EditFunc,
+	const FIntVector* ModifiedCellMin, const FIntVector* ModifiedCellMax)
 {
-	GridLock.Lock();
+	EGridLockResult LockResult = AcquireGridLock(true);
 
 	if (Grid)
 	{
+		if (DeltaTransaction.IsValid())
+			CaptureDeltaTransactionCells(ModifiedCellMin, ModifiedCellMax, LockResult == EGridLockResult::AlreadyHeld);
+
+		// copy-on-write if snapshots are referencing the grid. If the lock was already held
+		// we are nested inside another edit, which has already done this.
+		if (LockResult != EGridLockResult::AlreadyHeld && Grid.IsUnique() == false)
+		{
+			TRACE_CPUPROFILER_EVENT_SCOPE(UGSModelGrid::CopyOnWrite);
+			Grid = MakeShared<GS::ModelGrid>(*Grid);
+		}
+
 		EditFunc(*Grid);
 		GridEditCounter++;
+
+		if (ModifiedCellMin != nullptr && ModifiedCellMax != nullptr)
+			PendingChangeJournal.AddModifiedCells(*ModifiedCellMin, *ModifiedCellMax);
+		else
+			PendingChangeJournal.AddFullGridChange();
 	}
 
-	GridLock.Unlock();
+	ReleaseGridLock(LockResult, true);
+}
+
+void UGSModelGrid::BroadcastGridChanged(bool bFullGridChanged)
+{
+	EGridLockResult LockResult = AcquireGridLock(true);
+	FModelGridChangeJournal ChangeJournal = MoveTemp(PendingChangeJournal);
+	PendingChangeJournal.Reset();
+	ReleaseGridLock(LockResult, true);
+
+	if (bFullGridChanged || ChangeJournal.IsEmpty())
+		ChangeJournal.AddFullGridChange();
+
+	ModelGridReplacedEvent.Broadcast(this, ChangeJournal);
 }
 
 void UGSModelGrid::ResetGrid(bool bDeferUpdateNotification)
 {
-	EditGrid([](GS::ModelGrid& Grid) {
+	bool bRecordDelta = (GridEditStackDepth == 0) && (DeltaTransaction.IsValid() == false) && ShouldRecordDeltaTransaction();
+	if (bRecordDelta)
+		BeginDeltaTransaction();
+
+	EGridLockResult LockResult = AcquireGridLock(true);
+
+	if (Grid)
+	{
+		if (DeltaTransaction.IsValid())
+			CaptureDeltaTransactionCells(nullptr, nullptr, LockResult == EGridLockResult::AlreadyHeld);
+
 		GS::ModelGrid NewGrid;
-		NewGrid.Initialize(Grid.GetCellDimensions());
-		Grid = MoveTemp(NewGrid);
-	}, bDeferUpdateNotification);
+		NewGrid.Initialize(Grid->GetCellDimensions());
+		// if nested inside EditGrid, the outer EditFunc holds a reference to the current grid
+		if (LockResult == EGridLockResult::AlreadyHeld)
+			*Grid = MoveTemp(NewGrid);
+		else
+			Grid = MakeShared<GS::ModelGrid>(MoveTemp(NewGrid));
+		GridEditCounter++;
+		PendingChangeJournal.AddFullGridChange();
+	}
+
+	ReleaseGridLock(LockResult, true);
+
+	if (bRecordDelta)
+		EndDeltaTransaction();
+
+	if (GridEditStackDepth == 0 && bDeferUpdateNotification == false)
+		BroadcastGridChanged();
+}
+
+TSharedPtr<const GS::ModelGrid> UGSModelGrid::GetGridSnapshot()
+{
+	TSharedPtr<const GS::ModelGrid> Snapshot;
+
+	EGridLockResult LockResult = AcquireGridLock(false);
+	if (Grid)
+	{
+		// if this thread is inside EditGrid the grid may be modified after we return, so the snapshot must be a copy
+		GS::FHeldGridLock* HeldLock = GS::FindThreadHeldGridLock(this);
+		if (LockResult == EGridLockResult::AlreadyHeld && HeldLock != nullptr && HeldLock->bWriteLock)
+			Snapshot = MakeShared<GS::ModelGrid>(*Grid);
+		else
+			Snapshot = Grid;
+	}
+	ReleaseGridLock(LockResult, false);
 
+	return Snapshot;
 }
 
 
+
 void UGSModelGrid::BeginGridEdits()
 {
 	ensureMsgf(IsInGameThread(), TEXT("UGSModelGrid::BeginGridEdits called off the Game Thread!!"));
 
-	GridLock.Lock();
+	if (GridEditStackDepth == 0 && ShouldRecordDeltaTransaction())
+		BeginDeltaTransaction();
+
+	EGridLockResult LockResult = AcquireGridLock(true);
 	if (GridEditStackDepth == 0) {
 		uint32 CurCounter = GridEditCounter;
 		InitialGridEditCounter = CurCounter;
 	}
 	GridEditStackDepth++;
-	GridLock.Unlock();
+	ReleaseGridLock(LockResult, true);
 }
 
 void UGSModelGrid::EndGridEdits(bool bDeferNotification)
@@ -113,15 +370,19 @@ void UGSModelGrid::EndGridEdits(bool bDeferNotification)
 		return;
 	}
 
-	GridLock.Lock();
+	EGridLockResult LockResult = AcquireGridLock(true);
 	GridEditStackDepth--;
 	bool bNotify = (bDeferNotification == false)
 		&& (GridEditStackDepth == 0)
 		&& (GridEditCounter > InitialGridEditCounter);
-	GridLock.Unlock();
+	bool bEndDelta = (GridEditStackDepth == 0);
+	ReleaseGridLock(LockResult, true);
+
+	if (bEndDelta)
+		EndDeltaTransaction();
 
 	if (bNotify)
- 		ModelGridReplacedEvent.Broadcast(this);
+ 		BroadcastGridChanged();
 }
 
 
@@ -136,173 +397,702 @@ void UGSModelGrid::EndAllPendingGridEdits()
 }
 
 
-void UGSModelGrid::Serialize(FArchive& Archive)
+
+//
+// Delta undo transactions
+//
+// During an outer edit scope, each EditGridRegion() stores the previous values of the cells in
+// its region (in FModelGridChangeJournal::BlockSize^3 blocks, each block only once) before the
+// edit is applied. At the end of the scope the captured blocks are compared with the edited grid 
+// and only the modified cells are stored in the transaction buffer, instead of UObject::Serialize 
+// writing the entire grid for each transaction. Edits without a region (EditGrid(), ResetGrid())
+// can modify any cell, for those the grid itself is kept as the base and diffed at the end.
+//
+
+namespace GS
 {
-	TRACE_CPUPROFILER_EVENT_SCOPE(UGSModelGrid::Serialize);
+static void ComputeModelGridCellDeltas(const ModelGrid& BeforeGrid, const ModelGrid& AfterGrid, TArray<FModelGridCellDelta>& DeltasOut)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(ComputeModelGridCellDeltas);
 
-	Super::Serialize(Archive);
+	// new or modified cells
+	AfterGrid.EnumerateFilledCells([&](Vector3i CellIndex, const ModelGridCell& AfterCell, AxisBox3d LocalBounds)
+	{
+		bool bIsInGrid = false;
+		ModelGridCell BeforeCell = BeforeGrid.GetCellInfo(CellIndex, bIsInGrid);
+		if (bIsInGrid && IsSameModelGridCell(BeforeCell, AfterCell))
+			return;
+		if (bIsInGrid == false)
+			BeforeCell = MakeDefaultCellFromType(EModelGridCellType::Empty);
+		DeltasOut.Add(FModelGridCellDelta{ CellIndex, BeforeCell, AfterCell });
+	});
+
+	// erased cells
+	BeforeGrid.EnumerateFilledCells([&](Vector3i CellIndex, const ModelGridCell& BeforeCell, AxisBox3d LocalBounds)
+	{
+		bool bIsInGrid = false;
+		ModelGridCell AfterCell = AfterGrid.GetCellInfo(CellIndex, bIsInGrid);
+		if (bIsInGrid == false || AfterCell.CellType == EModelGridCellType::Empty)
+			DeltasOut.Add(FModelGridCellDelta{ CellIndex, BeforeCell, MakeDefaultCellFromType(EModelGridCellType::Empty) });
+	});
+}
+}
 
-	FScopeLock ScopeLock(&GridLock);
 
-	if (!Grid) 
-		return;
+class FModelGridCellDeltaChange : public FCommandChange
+{
+public:
+	GS::FCompressedModelGridCellDeltas CellDeltas;
+	bool bCellDimensionsChanged = false;
+	FVector3d CellDimensionsBefore, CellDimensionsAfter;
 
-	// skip undo/redo transaction serialization unless we want that...
-	if (bEnableTransactions == false && Archive.IsTransacting()) {
-		// write the same bytecount we write below so that if we end up trying
-		// to restore this record later, we don't crash
-		int64 ByteCount = 0;
-		Archive << ByteCount;
-		return;
+	virtual void Apply(UObject* Object) override
+	{
+		ApplyToGrid(Object, false);
+	}
+	virtual void Revert(UObject* Object) override
+	{
+		ApplyToGrid(Object, true);
+	}
+	virtual FString ToString() const override
+	{
+		return TEXT("ModelGrid Cell Delta");
 	}
 
-	if (Archive.IsLoading())
+protected:
+	// change notification is posted by UGSModelGrid::PostEditUndo
+	void ApplyToGrid(UObject* Object, bool bRevert)
 	{
-		InitializeNewGrid(false);
-		int64 ByteCount = 0;
-		Archive << ByteCount;
-		if (ByteCount > 0)
+		UGSModelGrid* TargetGrid = Cast<UGSModelGrid>(Object);
+		if (!ensure(TargetGrid != nullptr)) return;
+
+		TargetGrid->EditGridInternal([&](GS::ModelGrid& EditGrid)
 		{
-			GS::MemorySerializer Serializer;
-			Serializer.InitializeMemory((size_t)ByteCount);
-			size_t NumBytes = 0;
-			uint8_t* ByteBuffer = Serializer.GetWritableBuffer(NumBytes);
-			if (ensure((int64)NumBytes == ByteCount))
+			if (bCellDimensionsChanged)
+				EditGrid.SetNewCellDimensions(bRevert ? CellDimensionsBefore : CellDimensionsAfter);
+
+			GS::ModelGridEditor Editor(EditGrid);
+			CellDeltas.EnumerateDeltas([&](const GS::Vector3i& CellIndex, const GS::ModelGridCell& Before, const GS::ModelGridCell& After)
 			{
-				Archive.Serialize( ByteBuffer, ByteCount );
+				const GS::ModelGridCell& Cell = (bRevert) ? Before : After;
+				if (Cell.CellType == GS::EModelGridCellType::Empty)
+					Editor.EraseCell(CellIndex);
+				else
+					Editor.UpdateCell(CellIndex, Cell);
+			});
+		});
+	}
+};
+
+
+namespace GS
+{
+// union of the modified regions of both grids, returns false if both grids are empty
+static bool GetCombinedModifiedRegion(const ModelGrid& GridA, const ModelGrid& GridB, FIntVector& MinCellOut, FIntVector& MaxCellOut)
+{
+	bool bHaveRegion = false;
+	for (const ModelGrid* CurGrid : { &GridA, &GridB })
+	{
+		AxisBox3i Bounds = CurGrid->GetModifiedRegionBounds(0);
+		if (Bounds.Min.X > Bounds.Max.X || Bounds.Min.Y > Bounds.Max.Y || Bounds.Min.Z > Bounds.Max.Z)
+			continue;
+		FIntVector BoundsMin(Bounds.Min.X, Bounds.Min.Y, Bounds.Min.Z), BoundsMax(Bounds.Max.X, Bounds.Max.Y, Bounds.Max.Z);
+		MinCellOut = (bHaveRegion) ? FIntVector(FMath::Min(MinCellOut.X, BoundsMin.X), FMath::Min(MinCellOut.Y, BoundsMin.Y), FMath::Min(MinCellOut.Z, BoundsMin.Z)) : BoundsMin;
+		MaxCellOut = (bHaveRegion) ? FIntVector(FMath::Max(MaxCellOut.X, BoundsMax.X), FMath::Max(MaxCellOut.Y, BoundsMax.Y), FMath::Max(MaxCellOut.Z, BoundsMax.Z)) : BoundsMax;
+		bHaveRegion = true;
+	}
+	return bHaveRegion;
+}
+
+static ModelGridCell GetCellOrEmpty(const ModelGrid& Grid, const Vector3i& CellIndex)
+{
+	bool bIsInGrid = false;
+	ModelGridCell Cell = Grid.GetCellInfo(CellIndex, bIsInGrid);
+	return (bIsInGrid) ? Cell : MakeDefaultCellFromType(EModelGridCellType::Empty);
+}
 
-				Serializer.BeginRead();
-				GS::ModelGridSerializer::Restore(*Grid, Serializer);
+// returns true on the first cell in the inclusive range that differs between the grids
+static bool IsModelGridRangeModified(const ModelGrid& GridA, const ModelGrid& GridB, const FIntVector& MinCell, const FIntVector& MaxCell)
+{
+	for (int32 z = MinCell.Z; z <= MaxCell.Z; ++z)
+		for (int32 y = MinCell.Y; y <= MaxCell.Y; ++y)
+			for (int32 x = MinCell.X; x <= MaxCell.X; ++x)
+			{
+				Vector3i CellIndex(x, y, z);
+				if (IsSameModelGridCell(GetCellOrEmpty(GridA, CellIndex), GetCellOrEmpty(GridB, CellIndex)) == false)
+					return true;
 			}
-		}
+	return false;
+}
+}
+
+int32 UGSModelGrid::UpdateModifiedBlocksFromGrid(const GS::ModelGrid& SourceGrid, bool bDeferUpdateNotification)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UGSModelGrid::UpdateModifiedBlocksFromGrid);
+
+	TSharedPtr<const GS::ModelGrid> CurrentGrid = GetGridSnapshot();
+	if (CurrentGrid.IsValid() == false || CurrentGrid->GetCellDimensions() != SourceGrid.GetCellDimensions())
+	{
+		EditGrid([&](GS::ModelGrid& EditGrid) { EditGrid = SourceGrid; }, bDeferUpdateNotification);
+		return -1;
 	}
-	else
+
+	FIntVector RegionMin, RegionMax;
+	bool bHaveRegion = GS::GetCombinedModifiedRegion(*CurrentGrid, SourceGrid, RegionMin, RegionMax);
+	CurrentGrid.Reset();
+	if (bHaveRegion == false)
+		return 0;
+
+	TArray<FIntVector> CandidateBlocks;
+	FIntVector MinBlock = FModelGridChangeJournal::GetBlockIndex(RegionMin), MaxBlock = FModelGridChangeJournal::GetBlockIndex(RegionMax);
+	for (int32 bz = MinBlock.Z; bz <= MaxBlock.Z; ++bz)
+		for (int32 by = MinBlock.Y; by <= MaxBlock.Y; ++by)
+			for (int32 bx = MinBlock.X; bx <= MaxBlock.X; ++bx)
+				CandidateBlocks.Add(FIntVector(bx, by, bz));
+
+	return UpdateBlocksFromGridInternal(SourceGrid, CandidateBlocks, RegionMin, RegionMax, bDeferUpdateNotification);
+}
+
+int32 UGSModelGrid::UpdateModifiedBlocksFromGrid(const GS::ModelGrid& SourceGrid, const TSet<FIntVector>& CandidateBlocks, bool bDeferUpdateNotification)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UGSModelGrid::UpdateModifiedBlocksFromGrid_Candidates);
+
+	TSharedPtr<const GS::ModelGrid> CurrentGrid = GetGridSnapshot();
+	if (CurrentGrid.IsValid() == false || CurrentGrid->GetCellDimensions() != SourceGrid.GetCellDimensions())
 	{
-		GS::MemorySerializer Serializer;
-		Serializer.BeginWrite();
-		GS::ModelGridSerializer::Serialize(*Grid, Serializer);
+		EditGrid([&](GS::ModelGrid& EditGrid) { EditGrid = SourceGrid; }, bDeferUpdateNotification);
+		return -1;
+	}
+	CurrentGrid.Reset();
 
-		size_t NumBytes = 0;
-		const uint8_t* ByteBuffer = Serializer.GetBuffer(NumBytes);
+	const FIntVector NoClipMin(TNumericLimits<int32>::Lowest()), NoClipMax(TNumericLimits<int32>::Max());
+	return UpdateBlocksFromGridInternal(SourceGrid, CandidateBlocks.Array(), NoClipMin, NoClipMax, bDeferUpdateNotification);
+}
 
-		int64 ByteCount = (int64)NumBytes;
-		Archive << ByteCount;
-		if (ByteCount > 0)
+int32 UGSModelGrid::UpdateBlocksFromGridInternal(const GS::ModelGrid& SourceGrid, const TArray<FIntVector>& CandidateBlocks,
+	const FIntVector& ClipMin, const FIntVector& ClipMax, bool bDeferUpdateNotification)
+{
+	// cell range of a block, clipped to the region
+	auto GetBlockCellRange = [&](const FIntVector& BlockIndex, FIntVector& BlockMin, FIntVector& BlockMax)
+	{
+		const int32 BlockSize = FModelGridChangeJournal::BlockSize;
+		BlockMin = FIntVector(FMath::Max(BlockIndex.X * BlockSize, ClipMin.X), FMath::Max(BlockIndex.Y * BlockSize, ClipMin.Y), FMath::Max(BlockIndex.Z * BlockSize, ClipMin.Z));
+		BlockMax = FIntVector(FMath::Min(BlockIndex.X * BlockSize + BlockSize - 1, ClipMax.X), FMath::Min(BlockIndex.Y * BlockSize + BlockSize - 1, ClipMax.Y), FMath::Min(BlockIndex.Z * BlockSize + BlockSize - 1, ClipMax.Z));
+	};
+
+	// find the modified blocks. The snapshot is read without holding the grid lock.
+	TArray<FIntVector> ModifiedBlocks;
+	{
+		TSharedPtr<const GS::ModelGrid> CurrentGrid = GetGridSnapshot();
+		if (CurrentGrid.IsValid() == false)
+			return 0;
+		for (const FIntVector& BlockIndex : CandidateBlocks)
 		{
-			Archive.Serialize(const_cast<uint8_t*>(ByteBuffer), ByteCount);
+			FIntVector BlockMin, BlockMax;
+			GetBlockCellRange(BlockIndex, BlockMin, BlockMax);
+			if (GS::IsModelGridRangeModified(*CurrentGrid, SourceGrid, BlockMin, BlockMax))
+				ModifiedBlocks.Add(BlockIndex);
 		}
+	}		// release snapshot so the edits below do not need to copy-on-write
+	if (ModifiedBlocks.Num() == 0)
+		return 0;
+
+	// copy each modified block, inside a single edit scope so that only one notification/transaction is emitted
+	BeginGridEdits();
+	for (const FIntVector& BlockIndex : ModifiedBlocks)
+	{
+		FIntVector BlockMin, BlockMax;
+		GetBlockCellRange(BlockIndex, BlockMin, BlockMax);
+		EditGridRegion(BlockMin, BlockMax, [&](GS::ModelGrid& EditGrid)
+		{
+			GS::ModelGridEditor Editor(EditGrid);
+			GS::EnumerateCellsInRangeInclusive(BlockMin, BlockMax, [&](GS::Vector3i CellIndex)
+			{
+				GS::ModelGridCell SourceCell = GS::GetCellOrEmpty(SourceGrid, CellIndex);
+				if (GS::IsSameModelGridCell(SourceCell, GS::GetCellOrEmpty(EditGrid, CellIndex)))
+					return;
+				if (SourceCell.CellType == GS::EModelGridCellType::Empty)
+					Editor.EraseCell(CellIndex);
+				else
+					Editor.UpdateCell(CellIndex, SourceCell);
+			});
+		});
 	}
+	EndGridEdits(bDeferUpdateNotification);
 
+	return ModifiedBlocks.Num();
 }
 
+bool UGSModelGrid::ShouldRecordDeltaTransaction() const
+{
+#if WITH_EDITOR
+	return bEnableTransactions && bUseDeltaTransactions && GUndo != nullptr && IsInGameThread();
+#else
+	return false;
+#endif
+}
 
-void UGSModelGrid::PostLoad()
+struct UGSModelGrid::FDeltaTransactionState
 {
-	Super::PostLoad();
+	FVector3d CellDimensionsBefore = FVector3d::Zero();
 
-	// post change event...is this the right place?
-	ModelGridReplacedEvent.Broadcast(this);
+	//! previous cell values of each captured block, in X-fastest order. An empty array means all cells were empty.
+	TMap<FIntVector, TArray<GS::ModelGridCell>> CapturedBlocks;
+
+	//! set by the first edit without a modified region. Cells outside CapturedBlocks are diffed against this grid.
+	TSharedPtr<const GS::ModelGrid> FullGridBase;
+};
+
+void UGSModelGrid::BeginDeltaTransaction()
+{
+	if (DeltaTransaction.IsValid())
+		return;
+	DeltaTransaction = MakeShared<FDeltaTransactionState>();
+	ProcessGrid([&](const GS::ModelGrid& CurGrid) {
+		DeltaTransaction->CellDimensionsBefore = CurGrid.GetCellDimensions();
+	});
 }
 
-#if WITH_EDITOR
-void UGSModelGrid::PostEditUndo()
+void UGSModelGrid::CaptureDeltaTransactionCells(const FIntVector* MinCell, const FIntVector* MaxCell, bool bEditInPlace)
 {
-	Super::PostEditUndo();
-	ModelGridReplacedEvent.Broadcast(this);
+	FDeltaTransactionState& Transaction = *DeltaTransaction;
+
+	// the full base grid already has the previous values of all cells not captured before it
+	if (Transaction.FullGridBase.IsValid())
+		return;
+
+	const int32 BlockSize = FModelGridChangeJournal::BlockSize;
+	FIntVector MinBlock, MaxBlock;
+	bool bCaptureFullGrid = (MinCell == nullptr || MaxCell == nullptr);
+	if (bCaptureFullGrid == false)
+	{
+		MinBlock = FModelGridChangeJournal::GetBlockIndex(*MinCell);
+		MaxBlock = FModelGridChangeJournal::GetBlockIndex(*MaxCell);
+		int64 NumBlocks = (int64)(MaxBlock.X - MinBlock.X + 1) * (int64)(MaxBlock.Y - MinBlock.Y + 1) * (int64)(MaxBlock.Z - MinBlock.Z + 1);
+		bCaptureFullGrid = (NumBlocks + Transaction.CapturedBlocks.Num() > FModelGridChangeJournal::MaxTrackedBlocks);
+	}
+	if (bCaptureFullGrid)
+	{
+		// holding a reference forces the next edit to copy-on-write, so this is the grid before the edit.
+		// Nested edits modify the grid in place, in that case a copy is required.
+		if (bEditInPlace)
+			Transaction.FullGridBase = MakeShared<GS::ModelGrid>(*Grid);
+		else
+			Transaction.FullGridBase = Grid;
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(UGSModelGrid::CaptureDeltaTransactionCells);
+
+	// all cells outside the modified region are empty
+	GS::AxisBox3i OccupiedRegion = Grid->GetModifiedRegionBounds(0);
+	for (int32 bz = MinBlock.Z; bz <= MaxBlock.Z; ++bz)
+	{
+		for (int32 by = MinBlock.Y; by <= MaxBlock.Y; ++by)
+		{
+			for (int32 bx = MinBlock.X; bx <= MaxBlock.X; ++bx)
+			{
+				FIntVector BlockIndex(bx, by, bz);
+				if (Transaction.CapturedBlocks.Contains(BlockIndex))
+					continue;
+				TArray<GS::ModelGridCell>& BlockCells = Transaction.CapturedBlocks.Add(BlockIndex);
+
+				FIntVector BlockOrigin = BlockIndex * BlockSize;
+				bool bOverlapsOccupied = OccupiedRegion.IsValid()
+					&& BlockOrigin.X <= OccupiedRegion.Max.X && BlockOrigin.X + BlockSize - 1 >= OccupiedRegion.Min.X
+					&& BlockOrigin.Y <= OccupiedRegion.Max.Y && BlockOrigin.Y + BlockSize - 1 >= OccupiedRegion.Min.Y
+					&& BlockOrigin.Z <= OccupiedRegion.Max.Z && BlockOrigin.Z + BlockSize - 1 >= OccupiedRegion.Min.Z;
+				if (bOverlapsOccupied == false)
+					continue;
+
+				BlockCells.Reserve(BlockSize * BlockSize * BlockSize);
+				for (int32 z = 0; z < BlockSize; ++z)
+					for (int32 y = 0; y < BlockSize; ++y)
+						for (int32 x = 0; x < BlockSize; ++x)
+							BlockCells.Add(GS::GetCellOrEmpty(*Grid, GS::Vector3i(BlockOrigin.X + x, BlockOrigin.Y + y, BlockOrigin.Z + z)));
+			}
+		}
+	}
 }
-#endif
 
+void UGSModelGrid::EndDeltaTransaction()
+{
+	if (DeltaTransaction.IsValid() == false)
+		return;
+	TSharedPtr<FDeltaTransactionState> Transaction = MoveTemp(DeltaTransaction);
+
+	// transaction may have been cancelled during the edit scope
+	if (GUndo == nullptr)
+		return;
+	if (Transaction->CapturedBlocks.Num() == 0 && Transaction->FullGridBase.IsValid() == false)
+		return;		// no edits were made
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(UGSModelGrid::EndDeltaTransaction);
+
+	const int32 BlockSize = FModelGridChangeJournal::BlockSize;
+	const GS::ModelGridCell EmptyCell = GS::MakeDefaultCellFromType(GS::EModelGridCellType::Empty);
+
+	TUniquePtr<FModelGridCellDeltaChange> Change = MakeUnique<FModelGridCellDeltaChange>();
+	TArray<GS::FModelGridCellDelta> CellDeltas;
+	ProcessGrid([&](const GS::ModelGrid& CurGrid)
+	{
+		Change->CellDimensionsBefore = Transaction->CellDimensionsBefore;
+		Change->CellDimensionsAfter = CurGrid.GetCellDimensions();
+		Change->bCellDimensionsChanged = (Change->CellDimensionsBefore != Change->CellDimensionsAfter);
+
+		for (const TPair<FIntVector, TArray<GS::ModelGridCell>>& Pair : Transaction->CapturedBlocks)
+		{
+			FIntVector BlockOrigin = Pair.Key * BlockSize;
+			const TArray<GS::ModelGridCell>& BlockCells = Pair.Value;
+			int32 Index = 0;
+			for (int32 z = 0; z < BlockSize; ++z)
+			{
+				for (int32 y = 0; y < BlockSize; ++y)
+				{
+					for (int32 x = 0; x < BlockSize; ++x, ++Index)
+					{
+						GS::Vector3i CellIndex(BlockOrigin.X + x, BlockOrigin.Y + y, BlockOrigin.Z + z);
+						const GS::ModelGridCell& BeforeCell = (BlockCells.Num() > 0) ? BlockCells[Index] : EmptyCell;
+						GS::ModelGridCell AfterCell = GS::GetCellOrEmpty(CurGrid, CellIndex);
+						if (GS::IsSameModelGridCell(BeforeCell, AfterCell) == false)
+							CellDeltas.Add(GS::FModelGridCellDelta{ CellIndex, BeforeCell, AfterCell });
+					}
+				}
+			}
+		}
 
+		// cells in captured blocks already have their values from before the full-grid edit
+		if (Transaction->FullGridBase.IsValid() && Transaction->FullGridBase.Get() != &CurGrid)
+		{
+			TArray<GS::FModelGridCellDelta> FullGridDeltas;
+			GS::ComputeModelGridCellDeltas(*Transaction->FullGridBase, CurGrid, FullGridDeltas);
+			for (const GS::FModelGridCellDelta& Delta : FullGridDeltas)
+			{
+				if (Transaction->CapturedBlocks.Contains(FModelGridChangeJournal::GetBlockIndex(FIntVector(Delta.CellIndex.X, Delta.CellIndex.Y, Delta.CellIndex.Z))) == false)
+					CellDeltas.Add(Delta);
+			}
+		}
+	});
+	Transaction.Reset();
+	Change->CellDeltas.Compress(CellDeltas);
 
+	if (Change->CellDeltas.IsEmpty() == false || Change->bCellDimensionsChanged)
+	{
+		GUndo->StoreUndo(this, MoveTemp(Change));
+	}
+}
 
 
 
 //
-// T3D Encoding/Decoding 
-// Used to implement copy/paste and duplication in Editor
-// see similar UDynamicMesh.cpp functions for more info
+// FArchive encoding of ModelGrid
+//
+// Legacy format is an int64 ByteCount followed by the raw ModelGridSerializer buffer.
+// Current format writes ByteCount = ModelGridArchiveBlockFormat, followed by a small header and
+// the serializer buffer split into fixed-size blocks, each of which is optionally compressed.
+// Blocks are compressed directly from the serializer buffer into the archive, and decompressed
+// directly from the archive into the serializer buffer, so no second full-size copy is made.
 //
-
 
 namespace GS
 {
 
-class FGSModelGridReferenceStorage
+static TAutoConsoleVariable<int> CVarModelGridArchiveCompression(
+	TEXT("gradientspace.ModelGrid.ArchiveCompression"),
+	2,
+	TEXT("Compression used when serializing ModelGrids. 0 = None, 1 = LZ4, 2 = Oodle (falls back to LZ4 if not available)"));
+
+static constexpr int64 ModelGridArchiveBlockFormat = -1;
+static constexpr int32 ModelGridArchiveBlockFormatVersion = 1;
+static constexpr int32 ModelGridArchiveBlockSize = 256 * 1024;
+// limits used to reject corrupt archives before allocating memory
+static constexpr int32 ModelGridArchiveMaxBlockSize = 64 * 1024 * 1024;
+static constexpr int64 ModelGridArchiveMaxUncompressedSize = 16ll * 1024 * 1024 * 1024;
+
+enum class EModelGridArchiveCompression : uint8
 {
-protected:
-	struct FSourceModelGridRef {
-		TSoftObjectPtr<UGSModelGrid> SourceGrid;
-		FDateTime CreationTimestamp;
-	};
+	None = 0,
+	LZ4 = 1,
+	Oodle = 2
+};
 
-	static TMap<int32, FSourceModelGridRef> StoredGrids;
-	static FRandomStream KeyGenerator;
-public:
+static FName GetCompressionFormatName(EModelGridArchiveCompression Compression)
+{
+	switch (Compression) {
+		case EModelGridArchiveCompression::LZ4: return NAME_LZ4;
+		case EModelGridArchiveCompression::Oodle: return NAME_Oodle;
+		default: return NAME_None;
+	}
+}
+
+static EModelGridArchiveCompression GetActiveArchiveCompression()
+{
+	EModelGridArchiveCompression Compression = (EModelGridArchiveCompression)FMath::Clamp(CVarModelGridArchiveCompression.GetValueOnAnyThread(), 0, 2);
+	if (Compression == EModelGridArchiveCompression::Oodle && FCompression::IsFormatValid(NAME_Oodle) == false)
+		Compression = EModelGridArchiveCompression::LZ4;
+	return Compression;
+}
+
+static void SerializeModelGridToArchive(const ModelGrid& Grid, FArchive& Archive)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(SerializeModelGridToArchive);
+
+	GS::MemorySerializer Serializer;
+	Serializer.BeginWrite();
+	GS::ModelGridSerializer::Serialize(Grid, Serializer);
+
+	size_t NumBytes = 0;
+	const uint8_t* ByteBuffer = Serializer.GetBuffer(NumBytes);
+
+	int64 FormatMarker = ModelGridArchiveBlockFormat;
+	Archive << FormatMarker;
+	int32 FormatVersion = ModelGridArchiveBlockFormatVersion;
+	Archive << FormatVersion;
+
+	EModelGridArchiveCompression Compression = GetActiveArchiveCompression();
+	FName FormatName = GetCompressionFormatName(Compression);
+	uint8 CompressionType = (uint8)Compression;
+	Archive << CompressionType;
+
+	int64 UncompressedSize = (int64)NumBytes;
+	Archive << UncompressedSize;
+	int32 BlockSize = ModelGridArchiveBlockSize;
+	Archive << BlockSize;
+	int32 NumBlocks = (int32)((UncompressedSize + BlockSize - 1) / BlockSize);
+	Archive << NumBlocks;
+
+	TArray<uint8> CompressedBlock;
+	if (Compression != EModelGridArchiveCompression::None)
+		CompressedBlock.SetNumUninitialized(FCompression::CompressMemoryBound(FormatName, BlockSize));
 
-	static void Initialize()
+	for (int32 k = 0; k < NumBlocks; ++k)
 	{
-		static bool bInitialized = false;
-		if (!bInitialized) {
-			KeyGenerator = FRandomStream( (int32)FDateTime::UtcNow().ToUnixTimestamp() );
-			bInitialized = true;
+		int64 BlockStart = (int64)k * BlockSize;
+		int32 CurBlockSize = (int32)FMath::Min((int64)BlockSize, UncompressedSize - BlockStart);
+		uint8* BlockData = const_cast<uint8_t*>(ByteBuffer) + BlockStart;
+
+		// positive StoredSize is a compressed block, negative is stored uncompressed
+		int32 CompressedSize = CompressedBlock.Num();
+		bool bCompressed = (Compression != EModelGridArchiveCompression::None)
+			&& FCompression::CompressMemory(FormatName, CompressedBlock.GetData(), CompressedSize, BlockData, CurBlockSize)
+			&& CompressedSize < CurBlockSize;
+		if (bCompressed)
+		{
+			int32 StoredSize = CompressedSize;
+			Archive << StoredSize;
+			Archive.Serialize(CompressedBlock.GetData(), CompressedSize);
+		}
+		else
+		{
+			int32 StoredSize = -CurBlockSize;
+			Archive << StoredSize;
+			Archive.Serialize(BlockData, CurBlockSize);
 		}
 	}
+}
+
+// log the error and mark the archive as failed, so (eg) the package load fails rather than producing an empty grid
+static bool SetModelGridArchiveError(FArchive& Archive, const FString& Message)
+{
+	UE_LOG(LogGradientspace, Error, TEXT("[UGSModelGrid] Failed to restore ModelGrid from archive %s: %s"), *Archive.GetArchiveName(), *Message);
+	Archive.SetError();
+	return false;
+}
+
+// number of bytes remaining in the archive, or -1 if the archive size is unknown
+static int64 GetRemainingArchiveBytes(FArchive& Archive)
+{
+	int64 TotalSize = Archive.TotalSize();
+	return (TotalSize >= 0) ? FMath::Max(TotalSize - Archive.Tell(), (int64)0) : -1;
+}
 
-	static void CleanupCache()
+// all archive data is untrusted, header fields and block sizes are validated before any memory is allocated or written
+static bool RestoreModelGridFromArchive(ModelGrid& Grid, FArchive& Archive)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(RestoreModelGridFromArchive);
+
+	int64 ByteCount = 0;
+	Archive << ByteCount;
+	if (Archive.IsError())
+		return SetModelGridArchiveError(Archive, TEXT("could not read header"));
+
+	// legacy uncompressed format
+	if (ByteCount >= 0)
 	{
-		const int32 ExpiryTimeoutSeconds = 300;		// 5 minutes
+		if (ByteCount == 0)
+			return true;
+		int64 RemainingBytes = GetRemainingArchiveBytes(Archive);
+		if (ByteCount > ModelGridArchiveMaxUncompressedSize || (RemainingBytes >= 0 && ByteCount > RemainingBytes))
+			return SetModelGridArchiveError(Archive, FString::Printf(TEXT("invalid data size %lld"), ByteCount));
 
-		TArray<int32> ToRemove;
-		for (TPair<int32, FSourceModelGridRef>& Pair : StoredGrids) {
-			if ((FDateTime::Now() - Pair.Value.CreationTimestamp).GetTotalSeconds() > (double)ExpiryTimeoutSeconds)
-				ToRemove.Add(Pair.Key);
-		}
-		for (int32 ID : ToRemove)
-			StoredGrids.Remove(ID);
+		GS::MemorySerializer Serializer;
+		Serializer.InitializeMemory((size_t)ByteCount);
+		size_t NumBytes = 0;
+		uint8_t* ByteBuffer = Serializer.GetWritableBuffer(NumBytes);
+		if ((int64)NumBytes != ByteCount)
+			return SetModelGridArchiveError(Archive, TEXT("could not allocate data buffer"));
+		Archive.Serialize(ByteBuffer, ByteCount);
+		if (Archive.IsError())
+			return SetModelGridArchiveError(Archive, TEXT("could not read data"));
+		Serializer.BeginRead();
+		GS::ModelGridSerializer::Restore(Grid, Serializer);
+		return true;
 	}
 
-	static int32 StoreObjectReference(UGSModelGrid* SourceGrid)
+	if (ByteCount != ModelGridArchiveBlockFormat)
+		return SetModelGridArchiveError(Archive, FString::Printf(TEXT("unknown format marker %lld"), ByteCount));
+
+	int32 FormatVersion = 0;
+	Archive << FormatVersion;
+	uint8 CompressionType = 0;
+	Archive << CompressionType;
+	int64 UncompressedSize = 0;
+	Archive << UncompressedSize;
+	int32 BlockSize = 0;
+	Archive << BlockSize;
+	int32 NumBlocks = 0;
+	Archive << NumBlocks;
+	if (Archive.IsError())
+		return SetModelGridArchiveError(Archive, TEXT("could not read header"));
+	if (FormatVersion != ModelGridArchiveBlockFormatVersion)
+		return SetModelGridArchiveError(Archive, FString::Printf(TEXT("unknown format version %d"), FormatVersion));
+	if (CompressionType > (uint8)EModelGridArchiveCompression::Oodle)
+		return SetModelGridArchiveError(Archive, FString::Printf(TEXT("unknown compression type %d"), (int32)CompressionType));
+	if (BlockSize <= 0 || BlockSize > ModelGridArchiveMaxBlockSize)
+		return SetModelGridArchiveError(Archive, FString::Printf(TEXT("invalid block size %d"), BlockSize));
+	if (UncompressedSize < 0 || UncompressedSize > ModelGridArchiveMaxUncompressedSize)
+		return SetModelGridArchiveError(Archive, FString::Printf(TEXT("invalid data size %lld"), UncompressedSize));
+	int64 ExpectedNumBlocks = (UncompressedSize + BlockSize - 1) / BlockSize;
+	if ((int64)NumBlocks != ExpectedNumBlocks)
+		return SetModelGridArchiveError(Archive, FString::Printf(TEXT("block count %d does not match data size %lld"), NumBlocks, UncompressedSize));
+	if (UncompressedSize == 0)
+		return true;
+
+	EModelGridArchiveCompression Compression = (EModelGridArchiveCompression)CompressionType;
+	FName FormatName = GetCompressionFormatName(Compression);
+	if (Compression != EModelGridArchiveCompression::None && FCompression::IsFormatValid(FormatName) == false)
+		return SetModelGridArchiveError(Archive, FString::Printf(TEXT("compression format %s is not available"), *FormatName.ToString()));
+
+	GS::MemorySerializer Serializer;
+	Serializer.InitializeMemory((size_t)UncompressedSize);
+	size_t NumBytes = 0;
+	uint8_t* ByteBuffer = Serializer.GetWritableBuffer(NumBytes);
+	if ((int64)NumBytes != UncompressedSize)
+		return SetModelGridArchiveError(Archive, TEXT("could not allocate data buffer"));
+
+	TArray<uint8> CompressedBlock;
+	for (int32 k = 0; k < NumBlocks; ++k)
 	{
-		Initialize();
-		int32 StorageKey = FMath::Abs((int32)KeyGenerator.GetUnsignedInt());
+		// NumBlocks was validated above, so every block is non-empty and inside the buffer
+		int64 BlockStart = (int64)k * BlockSize;
+		int32 CurBlockSize = (int32)FMath::Min((int64)BlockSize, UncompressedSize - BlockStart);
+		uint8* BlockData = ByteBuffer + BlockStart;
+
+		int32 StoredSize = 0;
+		Archive << StoredSize;
+		if (Archive.IsError())
+			return SetModelGridArchiveError(Archive, FString::Printf(TEXT("could not read block %d"), k));
+
+		// the writer only stores a compressed block if it is smaller than the uncompressed block
+		int64 ReadSize = (StoredSize < 0) ? -(int64)StoredSize : (int64)StoredSize;
+		bool bValidSize = (StoredSize < 0) ? (-(int64)StoredSize == CurBlockSize)
+			: (StoredSize > 0 && StoredSize < CurBlockSize && Compression != EModelGridArchiveCompression::None);
+		int64 RemainingBytes = GetRemainingArchiveBytes(Archive);
+		if (bValidSize == false || (RemainingBytes >= 0 && ReadSize > RemainingBytes))
+			return SetModelGridArchiveError(Archive, FString::Printf(TEXT("invalid size %d for block %d"), StoredSize, k));
+
+		if (StoredSize < 0)
+		{
+			Archive.Serialize(BlockData, CurBlockSize);
+		}
+		else
+		{
+			CompressedBlock.SetNumUninitialized(StoredSize);
+			Archive.Serialize(CompressedBlock.GetData(), StoredSize);
+			if (Archive.IsError() == false && FCompression::UncompressMemory(FormatName, BlockData, CurBlockSize, CompressedBlock.GetData(), StoredSize) == false)
+				return SetModelGridArchiveError(Archive, FString::Printf(TEXT("could not decompress block %d"), k));
+		}
+		if (Archive.IsError())
+			return SetModelGridArchiveError(Archive, FString::Printf(TEXT("could not read block %d"), k));
+	}
+
+	Serializer.BeginRead();
+	GS::ModelGridSerializer::Restore(Grid, Serializer);
+	return true;
+}
+
+}
+
+
+
+void UGSModelGrid::Serialize(FArchive& Archive)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UGSModelGrid::Serialize);
 
-		FSourceModelGridRef NewMesh;
-		NewMesh.CreationTimestamp = FDateTime::Now();
-		NewMesh.SourceGrid = SourceGrid;
-		StoredGrids.Add(StorageKey, MoveTemp(NewMesh));
+	Super::Serialize(Archive);
+
+	// loading replaces the grid, saving/transacting only needs to read it
+	const bool bWriteLock = Archive.IsLoading();
+	EGridLockResult LockResult = AcquireGridLock(bWriteLock);
+	ON_SCOPE_EXIT { ReleaseGridLock(LockResult, bWriteLock); };
+
+	if (!Grid) 
+		return;
 
-		CleanupCache();
-		return StorageKey;
+	// skip undo/redo transaction serialization unless we want that. In delta mode the
+	// transaction records only the modified cells, see EndDeltaTransaction()
+	if ((bEnableTransactions == false || bUseDeltaTransactions) && Archive.IsTransacting()) {
+		// write the same bytecount we write below so that if we end up trying
+		// to restore this record later, we don't crash
+		int64 ByteCount = 0;
+		Archive << ByteCount;
+		return;
 	}
 
-	static TUniquePtr<GS::ModelGrid> FindObjectReferenceAndGetDataCopy(int32 StorageKey, bool& bFoundOut)
+	if (Archive.IsLoading())
 	{
-		TUniquePtr<GS::ModelGrid> ResultGrid;
-		bFoundOut = false;
-
-		FSourceModelGridRef* Found = StoredGrids.Find(StorageKey);
-		if (Found != nullptr && Found->SourceGrid.IsValid())
+		InitializeNewGrid(false);
+		if (GS::RestoreModelGridFromArchive(*Grid, Archive) == false)
 		{
-			ResultGrid = MakeUnique<GS::ModelGrid>();
-			UGSModelGrid* SourceGrid = Found->SourceGrid.Get();
-			if (SourceGrid) {
-				SourceGrid->ProcessGrid([&](const GS::ModelGrid& ReadGrid) {
-					*ResultGrid = ReadGrid;
-					bFoundOut = true;
-				});
-			}
+			// Restore has already marked the archive as failed, discard any partially-restored data
+			UE_LOG(LogGradientspace, Error, TEXT("[UGSModelGrid] Grid data for %s could not be loaded"), *GetPathName());
+			InitializeNewGrid(false);
 		}
-
-		CleanupCache();
-		return ResultGrid;
 	}
-};
-// declare static members
-TMap<int32, FGSModelGridReferenceStorage::FSourceModelGridRef> FGSModelGridReferenceStorage::StoredGrids;
-FRandomStream FGSModelGridReferenceStorage::KeyGenerator;
+	else
+	{
+		GS::SerializeModelGridToArchive(*Grid, Archive);
+	}
+
+}
+
 
+void UGSModelGrid::PostLoad()
+{
+	Super::PostLoad();
+
+	// post change event...is this the right place?
+	BroadcastGridChanged(true);
+}
+
+#if WITH_EDITOR
+void UGSModelGrid::PostEditUndo()
+{
+	Super::PostEditUndo();
+	BroadcastGridChanged(true);
 }
+#endif
+
+
+
+
+
 
+//
+// T3D Encoding/Decoding 
+// Used to implement copy/paste and duplication in Editor
+// see similar UDynamicMesh.cpp functions for more info
+//
 
 
 void UGSModelGrid::ExportCustomProperties(FOutputDevice& Out, uint32 Indent)
@@ -311,14 +1101,20 @@ void UGSModelGrid::ExportCustomProperties(FOutputDevice& Out, uint32 Indent)
 	Out.Logf(TEXT("%sCustomProperties "), FCString::Spc(Indent));
 	Out.Logf(TEXT("ModelGridData "));
 
-	// store object reference to circumvent expensive T3D generation/parsing
-	int32 StoredObjectKey = GS::FGSModelGridReferenceStorage::StoreObjectReference(this);
-	Out.Logf(TEXT("STOREDKEY=%d "), StoredObjectKey);
+	TRACE_CPUPROFILER_EVENT_SCOPE(UGSModelGrid::ExportCustomProperties);
 
-	// todo: implement base64 encoding like UDynamicMesh
+	// same compressed block encoding as ::Serialize, stored inline as base64, so the
+	// T3D text is self-contained and can be pasted into another editor session
+	TArray<uint8> GridBytes;
+	FMemoryWriter Writer(GridBytes);
+	ProcessGrid([&](const GS::ModelGrid& ReadGrid) {
+		GS::SerializeModelGridToArchive(ReadGrid, Writer);
+	});
 
+	FString EncodedGrid = FBase64::Encode(GridBytes);
+	Out.Logf(TEXT("BINARYSIZE=%d BINARYDATA="), GridBytes.Num());
+	Out.Log(EncodedGrid);		// Log, not Logf, encoded string may be very large
 	Out.Logf(TEXT("\r\n"));
-
 }
 
 void UGSModelGrid::ImportCustomProperties(const TCHAR* SourceText, FFeedbackContext* Warn)
@@ -327,35 +1123,48 @@ void UGSModelGrid::ImportCustomProperties(const TCHAR* SourceText, FFeedbackCont
 
 	if (FParse::Command(&SourceText, TEXT("ModelGridData")))	
 	{
-		// we are overwriting grid
-		InitializeNewGrid(false);
+		TRACE_CPUPROFILER_EVENT_SCOPE(UGSModelGrid::ImportCustomProperties);
 
-		// extract stored object key from string
-		static const TCHAR KeyToken[] = TEXT("STOREDKEY=");
-		const TCHAR* FoundKeyStart = FCString::Strifind(SourceText, KeyToken);
-		if (FoundKeyStart)
+		static const TCHAR SizeToken[] = TEXT("BINARYSIZE=");
+		static const TCHAR DataToken[] = TEXT("BINARYDATA=");
+		const TCHAR* FoundSizeStart = FCString::Strifind(SourceText, SizeToken);
+		const TCHAR* FoundDataStart = FCString::Strifind(SourceText, DataToken);
+		if (FoundSizeStart == nullptr || FoundDataStart == nullptr)
 		{
-			SourceText = FoundKeyStart + FCString::Strlen(KeyToken);
-			int32 ObjectKey = FCString::Atoi(SourceText);
+			// older T3D text stored a key into a (per-process) map of source grids, which is no longer supported
+			UE_LOG(LogGradientspace, Warning, TEXT("[UGSModelGrid] T3D ModelGridData does not contain BINARYDATA, grid cannot be imported"));
+			return;
+		}
 
-			// try to  find grid via key
-			bool bFoundValid = false;
-			// this data is a copy that we now own
-			TUniquePtr<GS::ModelGrid> FoundGrid = GS::FGSModelGridReferenceStorage::FindObjectReferenceAndGetDataCopy(ObjectKey, bFoundValid);
+		int32 ExpectedNumBytes = FCString::Atoi(FoundSizeStart + FCString::Strlen(SizeToken));
 
-			if (FoundGrid.IsValid() && bFoundValid)
-			{
-				// do not post notifications from this edit - we are just deserializing, let other things handle it
-				this->EditGridInternal([&](GS::ModelGrid& EditGrid) {
-					EditGrid = MoveTemp(*FoundGrid);
-				});
-				return;
-			}
+		const TCHAR* DataStart = FoundDataStart + FCString::Strlen(DataToken);
+		const TCHAR* DataEnd = DataStart;
+		while (*DataEnd != TCHAR('\0') && FChar::IsWhitespace(*DataEnd) == false)
+			DataEnd++;
+
+		FString EncodedGrid((int32)(DataEnd - DataStart), DataStart);
+		TArray<uint8> GridBytes;
+		// pasted text is untrusted, do not let the size token drive the allocation
+		GridBytes.Reserve(FMath::Clamp(ExpectedNumBytes, 0, EncodedGrid.Len()));
+		bool bDecoded = FBase64::Decode(EncodedGrid, GridBytes);
+		if (bDecoded == false || GridBytes.Num() != ExpectedNumBytes)
+		{
+			UE_LOG(LogGradientspace, Warning, TEXT("[UGSModelGrid] T3D ModelGridData could not be decoded, grid cannot be imported"));
+			return;
 		}
 
-		ensureMsgf(false, TEXT("UGSModelGrid: stored object pointer is not valid and T3D Import via text encoding is not supported yet"));
-		return;
+		GS::ModelGrid NewGrid;
+		FMemoryReader Reader(GridBytes);
+		if (GS::RestoreModelGridFromArchive(NewGrid, Reader) == false)
+		{
+			UE_LOG(LogGradientspace, Warning, TEXT("[UGSModelGrid] T3D ModelGridData could not be restored, grid cannot be imported"));
+			return;
+		}
 
-		// todo: implement base64 decoding like UDynamicMesh
+		// do not post notifications from this edit - we are just deserializing, let other things handle it
+		this->EditGridInternal([&](GS::ModelGrid& EditGrid) {
+			EditGrid = MoveTemp(NewGrid);
+		});
 	}
 }
@@ -6,7 +6,8 @@ using namespace GS;
 
 
 FMeshRenderBuffers::FMeshRenderBuffers(ERHIFeatureLevel::Type FeatureLevelType)
-	: VertexFactory(FeatureLevelType, "FMeshRenderBuffers")
+	: VertexFactory(FeatureLevelType, "FMeshRenderBuffers"),
+	FeatureLevel(FeatureLevelType)
 {
 	//StaticMeshVertexBuffer.SetUseFullPrecisionUVs(true);
 	//StaticMeshVertexBuffer.SetUseHighPrecisionTangentBasis(true);
@@ -88,7 +89,8 @@ void FMeshRenderBuffers::InitOrUpdateResource(FRHICommandListImmediate& RHICmdLi
 
 void FMeshRenderBuffers::EnqueueDeleteOnRenderThread(FMeshRenderBuffers* RenderBuffers)
 {
-	if (RenderBuffers->TriangleCount > 0)
+	// always delete, destructor only releases resources if TriangleCount > 0
+	if (RenderBuffers != nullptr)
 	{
 		ENQUEUE_RENDER_COMMAND(FMeshRenderBuffers_DestroyBuffers)(
 			[RenderBuffers](FRHICommandListImmediate& RHICmdList)
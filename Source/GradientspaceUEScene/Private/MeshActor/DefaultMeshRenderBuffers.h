@@ -28,6 +28,9 @@ public:
 
 	UMaterialInterface* Material = nullptr;
 
+	//! feature level these buffers were constructed for
+	ERHIFeatureLevel::Type FeatureLevel;
+
 
 	FMeshRenderBuffers(ERHIFeatureLevel::Type FeatureLevelType);
 
@@ -29,7 +29,7 @@ FDenseMeshSceneProxy::~FDenseMeshSceneProxy()
 	check(IsInRenderingThread());
 
 	// enqueue render thread command to free render buffers
-	if (AllocatedRenderBuffers && AllocatedRenderBuffers->TriangleCount > 0)
+	if (AllocatedRenderBuffers)
 	{
 		FMeshRenderBuffers::EnqueueDeleteOnRenderThread(AllocatedRenderBuffers);
 		AllocatedRenderBuffers = nullptr;
@@ -81,6 +81,23 @@ void FDenseMeshSceneProxy::InitializeFromMesh_LocalOptimize(const DenseMesh& Mes
 }
 
 
+void FDenseMeshSceneProxy::InitializeFromPrebuiltBuffers(FMeshRenderBuffers* PrebuiltBuffers)
+{
+	check(AllocatedRenderBuffers == nullptr);
+	AllocatedRenderBuffers = PrebuiltBuffers;
+	if (AllocatedRenderBuffers != nullptr)
+	{
+		if (AllocatedRenderBuffers->Material == nullptr)
+			AllocatedRenderBuffers->Material = UMaterial::GetDefaultMaterial(MD_Surface);
+
+		ENQUEUE_RENDER_COMMAND(FDenseMeshSceneProxy_Upload)(
+			[this](FRHICommandListImmediate& RHICmdList) {
+			AllocatedRenderBuffers->Upload(RHICmdList);
+		});
+	}
+}
+
+
 void FDenseMeshSceneProxy::GetDynamicMeshElements(const TArray<const FSceneView*>& Views, const FSceneViewFamily& ViewFamily, uint32 VisibilityMap, class FMeshElementCollector& Collector) const
 {
 	if (AllocatedRenderBuffers == nullptr) return;
@@ -16,7 +16,7 @@ class FDenseMeshSceneProxy : public FPrimitiveSceneProxy
 protected:
 	FMaterialRelevance MaterialRelevance;
 
-	FMeshRenderBuffers* AllocatedRenderBuffers;
+	FMeshRenderBuffers* AllocatedRenderBuffers = nullptr;
 
 	bool bUseDynamicDrawPath = false;
 
@@ -28,6 +28,8 @@ public:
 	void InitializeRenderBuffers();
 	void InitializeFromMesh_Fastest(const DenseMesh& Mesh);
 	void InitializeFromMesh_LocalOptimize(const DenseMesh& Mesh);
+	//! take ownership of RenderBuffers that were already filled (eg on a background task). Only the RHI upload is done here (on the render thread).
+	void InitializeFromPrebuiltBuffers(FMeshRenderBuffers* PrebuiltBuffers);
 
 
 public:
@@ -2,7 +2,11 @@
 
 #include "MeshActor/GSMeshComponent.h"
 #include "MeshActor/DenseMeshSceneProxy.h"
+#include "MeshActor/DefaultMeshRenderBuffers.h"
+#include "MeshActor/RenderBufferUtil.h"
+#include "GSJobSubsystem.h"
 
+#include "Engine/World.h"
 #include "VectorUtil.h"
 #include "BoxTypes.h"
 
@@ -12,7 +16,7 @@ using namespace GS;
 
 UGSMeshComponent::UGSMeshComponent()
 {
-	Mesh = MakeUnique<DenseMesh>();
+	Mesh = MakeShared<DenseMesh>();
 }
 
 
@@ -28,6 +32,12 @@ void UGSMeshComponent::EditMesh(TFunctionRef<void(DenseMesh& Mesh)> UpdateFunc)
 {
 	if (Mesh.IsValid())
 	{
+		// an in-flight render buffer job may still be reading the current mesh
+		if (Mesh.IsUnique() == false)
+		{
+			Mesh = MakeShared<DenseMesh>(*Mesh);
+		}
+
 		UpdateFunc(*Mesh);
 
 		FAxisAlignedBox3d TmpBounds = FAxisAlignedBox3d::Empty();
@@ -39,8 +49,101 @@ void UGSMeshComponent::EditMesh(TFunctionRef<void(DenseMesh& Mesh)> UpdateFunc)
 
 		LocalBounds = (FBox)TmpBounds;
 
-		MarkRenderStateDirty();
+		RenderBufferRevision++;
+
+		if (bBuildRenderBuffersAsync && Mesh->GetTriangleCount() > 0)
+		{
+			// existing SceneProxy (or not-yet-displayed ReadyRenderBuffers) stay visible until the job posts new buffers
+			LaunchRenderBufferBuild();
+		}
+		else
+		{
+			// SceneProxy will be built from the current mesh, so any in-flight job result is older
+			DisplayedRenderBufferRevision = RenderBufferRevision;
+			ReleaseReadyRenderBuffers();
+			MarkRenderStateDirty();
+		}
+	}
+}
+
+
+void UGSMeshComponent::LaunchRenderBufferBuild()
+{
+	struct FRenderBufferJob
+	{
+		TSharedPtr<const DenseMesh> SourceMesh;
+		FMeshRenderBuffers* RenderBuffers = nullptr;
+		int64 Revision = 0;
+
+		~FRenderBufferJob()
+		{
+			// buffers were not taken by the Component (eg job was discarded), must be deleted on render thread
+			if (RenderBuffers != nullptr)
+				FMeshRenderBuffers::EnqueueDeleteOnRenderThread(RenderBuffers);
+		}
+	};
+	TSharedPtr<FRenderBufferJob> JobData = MakeShared<FRenderBufferJob>();
+	JobData->SourceMesh = Mesh;
+	JobData->Revision = RenderBufferRevision;
+
+	UWorld* World = GetWorld();
+	ERHIFeatureLevel::Type FeatureLevel = (World != nullptr) ? World->GetFeatureLevel() : GMaxRHIFeatureLevel;
+	JobData->RenderBuffers = new FMeshRenderBuffers(FeatureLevel);
+
+	UGSJobSubsystem::EnqueueStandardJob(
+		this, this,
+		[JobData]() {
+			// always build the buffers, even if another edit has been made since. The result is still
+			// newer than the displayed buffers, and the job for the later edit will replace it.
+			GS::InitializeRenderBuffersFromMesh_LocalOptimize(*JobData->SourceMesh, *JobData->RenderBuffers);
+			JobData->SourceMesh.Reset();
+			return true;
+		},
+		[JobData, this]()
+		{
+			FMeshRenderBuffers* NewRenderBuffers = JobData->RenderBuffers;
+			JobData->RenderBuffers = nullptr;
+			this->OnRenderBuffersBuilt(NewRenderBuffers, JobData->Revision);
+		},
+		UGSJobSubsystem::FJobOptions::ThreadSafe(TEXT("RenderBuffers")));
+}
+
+
+void UGSMeshComponent::OnRenderBuffersBuilt(FMeshRenderBuffers* NewRenderBuffers, int64 Revision)
+{
+	// latest wins: any result newer than the displayed buffers is shown, so continuous edits still update
+	if (Revision <= DisplayedRenderBufferRevision || NewRenderBuffers->TriangleCount == 0)
+	{
+		FMeshRenderBuffers::EnqueueDeleteOnRenderThread(NewRenderBuffers);
+		return;
 	}
+
+	ReleaseReadyRenderBuffers();
+	ReadyRenderBuffers = NewRenderBuffers;
+	DisplayedRenderBufferRevision = Revision;
+
+	// new SceneProxy will take the ReadyRenderBuffers
+	MarkRenderStateDirty();
+}
+
+
+void UGSMeshComponent::ReleaseReadyRenderBuffers()
+{
+	if (ReadyRenderBuffers != nullptr)
+	{
+		FMeshRenderBuffers::EnqueueDeleteOnRenderThread(ReadyRenderBuffers);
+		ReadyRenderBuffers = nullptr;
+	}
+}
+
+
+void UGSMeshComponent::BeginDestroy()
+{
+	// discard any in-flight jobs
+	DisplayedRenderBufferRevision = ++RenderBufferRevision;
+	ReleaseReadyRenderBuffers();
+
+	Super::BeginDestroy();
 }
 
 
@@ -60,7 +163,23 @@ FPrimitiveSceneProxy* UGSMeshComponent::CreateSceneProxy()
 {
 	FDenseMeshSceneProxy* NewSceneProxy = nullptr;
 
-	ProcessMesh([&](const DenseMesh& Mesh) 
+	// use buffers from background job if they are available and compatible with this scene
+	if (ReadyRenderBuffers != nullptr)
+	{
+		if (ReadyRenderBuffers->FeatureLevel == GetScene()->GetFeatureLevel())
+		{
+			NewSceneProxy = new FDenseMeshSceneProxy(this);
+			NewSceneProxy->InitializeFromPrebuiltBuffers(ReadyRenderBuffers);
+			ReadyRenderBuffers = nullptr;
+			return NewSceneProxy;
+		}
+		ReleaseReadyRenderBuffers();
+	}
+
+	// proxy is built from the current mesh, results of in-flight jobs are older
+	DisplayedRenderBufferRevision = RenderBufferRevision;
+
+	ProcessMesh([&](const DenseMesh& Mesh)
 	{
 		if (Mesh.GetTriangleCount() > 0)
 		{
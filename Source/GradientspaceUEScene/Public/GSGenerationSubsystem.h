@@ -12,6 +12,9 @@ class AGSGeneratedModelGridActor;
 /**
  * GSGenerationSubsystem handles regeneration of procedural actors, currently only GeneratedModelGridActor.
  * 
+ * Pending regenerations are spread across frames, nearest-to-camera first, limited by 
+ * the gradientspace.Generation.FrameBudgetMs time budget.
+ * 
  * TODO: refactor into Subsystem and manager object, like GSJobSubsystem. This will allow
  *    alternate Managers to be dynamically swapped in, eg so different Tick() policies can be 
  *    added by clients
@@ -42,9 +45,19 @@ public:
 	static bool RegisterGeneratedActor(AActor* Actor);
 	static bool UnregisterGeneratedActor(AActor* Actor);
 
+	/**
+	 * Registered actors must call this when they are marked for regeneration. Only actors in the 
+	 * pending set are visited in Tick(), and the subsystem does not tick while the set is empty.
+	 */
+	virtual void MarkModelGridRegenerationPending(AGSGeneratedModelGridActor* Actor);
+	static void NotifyRegenerationPending(AActor* Actor);
+
 protected:
 	TSet<AGSGeneratedModelGridActor*> ActiveGeneratedModelGrids;
 
+	// subset of ActiveGeneratedModelGrids that are waiting for ExecuteRegenerateIfPending()
+	TSet<AGSGeneratedModelGridActor*> PendingRegenerationModelGrids;
+
 
 
 public:
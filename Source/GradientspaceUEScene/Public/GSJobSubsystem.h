@@ -3,6 +3,7 @@
 
 #include "Subsystems/EngineSubsystem.h"
 #include "Tickable.h"
+#include <atomic>
 
 #include "GSJobSubsystem.generated.h"
 
@@ -23,9 +24,9 @@ protected:
 public:
 	UGSJobSubsystem();
 
-	//! this counter increments once per tick of the engine subsystem. The subsystem
-	//! ticks with the game thread. So this can be used to identify things happening
-	//! on the same game-thread-tick (eg to avoid sending duplicate jobs/etc)
+	//! returns the engine frame counter (GFrameCounter), which increments once per game-thread frame
+	//! even when the job manager is idle (it only ticks while it has work). So this can be used to identify 
+	//! things happening on the same game-thread-tick (eg to avoid sending duplicate jobs/etc)
 	static uint64 GetGlobalTickCounter();
 
 
@@ -36,11 +37,28 @@ public:
 		uint64 Timestamp = 0;
 	};
 
+	//! pending jobs are launched in priority order, and FIFO within a priority. Game-thread updates are run in the same order.
+	enum class EJobPriority : uint8
+	{
+		High = 0,
+		Normal = 1,
+		Background = 2
+	};
+
 	struct FJobOptions
 	{
 		bool bComputeFuncIsThreadSafe = false;
+
+		EJobPriority Priority = EJobPriority::Normal;
+
+		//! if set, enqueuing a job with the same Target and DedupeKey cancels any earlier job with that key that has not been launched yet
+		FName DedupeKey = NAME_None;
 		
 		static FJobOptions ThreadSafe() { FJobOptions Tmp; Tmp.bComputeFuncIsThreadSafe = true; return Tmp; }
+		static FJobOptions ThreadSafe(FName DedupeKey, EJobPriority Priority = EJobPriority::Normal) 
+		{ 
+			FJobOptions Tmp = ThreadSafe(); Tmp.DedupeKey = DedupeKey; Tmp.Priority = Priority; return Tmp;
+		}
 	};
 
 	struct FPendingJob
@@ -51,9 +69,74 @@ public:
 		TFunction<void()> GameThreadUpdateFunc;
 
 		FJobOptions Options;
+
+		std::atomic<bool> bCancelled = false;
+
+		// FPlatformTime::Seconds() timestamps, used for job statistics
+		double EnqueueTime = 0;
+		double LaunchTime = 0;
+	};
+
+	/**
+	 * Handle to an enqueued job. Cancelling a job that has not been launched prevents it from running,
+	 * otherwise the ComputeFunc runs to completion (it is not interrupted) but the GameThreadUpdateFunc is skipped.
+	 */
+	struct FJobHandle
+	{
+		TWeakPtr<FPendingJob> Job;
+
+		bool IsValid() const { return Job.IsValid(); }
+		void Cancel() { if (TSharedPtr<FPendingJob> Pinned = Job.Pin()) Pinned->bCancelled = true; }
+		bool IsCancelled() const { TSharedPtr<FPendingJob> Pinned = Job.Pin(); return Pinned.IsValid() && Pinned->bCancelled; }
+	};
+
+	//! distribution of job timings, in milliseconds
+	struct FJobTimingHistogram
+	{
+		static constexpr int32 NumBuckets = 8;
+		//! upper bound of each bucket in ms, the last bucket is unbounded
+		static constexpr double BucketUpperBoundsMs[NumBuckets] = { 0.1, 0.5, 1.0, 2.0, 5.0, 10.0, 50.0, TNumericLimits<double>::Max() };
+
+		int64 BucketCounts[NumBuckets] = {};
+		int64 NumSamples = 0;
+		double TotalMs = 0;
+		double MaxMs = 0;
+
+		void AddSample(double TimeMs);
+		double GetAverageMs() const { return (NumSamples > 0) ? (TotalMs / (double)NumSamples) : 0.0; }
+	};
+
+	struct FJobStatistics
+	{
+		int64 NumEnqueued = 0;
+		int64 NumLaunched = 0;
+		//! ComputeFunc returned true and the game thread update ran
+		int64 NumCompleted = 0;
+		//! ComputeFunc returned false, ie the job decided its result was no longer needed
+		int64 NumDiscarded = 0;
+		//! cancelled via FJobHandle, or skipped because the Owner/Target was destroyed
+		int64 NumCancelled = 0;
+		//! replaced by a newer job with the same DedupeKey before launching
+		int64 NumSuperseded = 0;
+
+		int32 QueueDepth = 0;
+		int32 MaxQueueDepth = 0;
+		int32 NumRunning = 0;
+		int32 NumPendingGameThreadUpdates = 0;
+
+		//! time from enqueue to launch
+		FJobTimingHistogram WaitTime;
+		//! ComputeFunc execution time
+		FJobTimingHistogram RunTime;
+		//! GameThreadUpdateFunc execution time
+		FJobTimingHistogram GameThreadUpdateTime;
 	};
 
-	static void EnqueueStandardJob(
+	//! returns a copy of the statistics of the default job manager (also see console command gradientspace.Jobs.DumpStats)
+	static FJobStatistics GetJobStatistics();
+	static void ResetJobStatistics();
+
+	static FJobHandle EnqueueStandardJob(
 		UObject* Owner, UObject* Target,
 		TFunction<bool()>&& ComputeFunc,
 		TFunction<void()>&& GameThreadUpdateFunc,
@@ -83,7 +166,7 @@ class GRADIENTSPACEUESCENE_API UBaseGSJobManager : public UObject, public FTicka
 	GENERATED_BODY()
 public:
 
-	virtual void EnqueueStandardJob(
+	virtual UGSJobSubsystem::FJobHandle EnqueueStandardJob(
 		UObject* Owner, UObject* Target, 
 		TFunction<bool()>&& ComputeFunc,
 		TFunction<void()>&& GameThreadUpdateFunc,
@@ -93,7 +176,11 @@ public:
 		UObject* Owner, UObject* Target,
 		TFunction<void()>&& GameThreadFunc);
 
-	uint64 GetGlobalTickCounter() const { return TickCounter; }
+	//! the manager does not tick while idle, so this is the engine frame counter
+	uint64 GetGlobalTickCounter() const { return GFrameCounter; }
+
+	UGSJobSubsystem::FJobStatistics GetJobStatistics() const;
+	void ResetJobStatistics();
 
 public:
 	//~ Begin FTickableGameObject interface
@@ -106,18 +193,38 @@ public:
 
 
 protected:
+	// jobs that have not been launched yet. Protected by PendingJobsLock, jobs may be enqueued from background jobs
 	TArray<TSharedPtr<UGSJobSubsystem::FPendingJob>> PendingJobs;
+	FCriticalSection PendingJobsLock;
 
-	std::atomic<uint64> TickCounter = 0;
+	// number of thread-safe jobs currently executing, limited by gradientspace.Jobs.MaxConcurrentJobs
+	std::atomic<int32> NumRunningJobs = 0;
+
+	// sizes of PendingJobs/PendingGameThreadUpdates/PendingTickJobs, so that IsTickable() does not need to take the locks
+	std::atomic<int32> NumQueuedJobs = 0;
+	std::atomic<int32> NumQueuedGameThreadUpdates = 0;
+	std::atomic<int32> NumQueuedTickJobs = 0;
 
 	// not clear what this counter is for, exactly...increments on tick but also whenever a job is enqueued?
 	std::atomic<uint64> TimestampCounter = 0;
 
 	void ExecuteStandardJob(TSharedPtr<UGSJobSubsystem::FPendingJob>& Job);
+	//! launch pending jobs in priority order, up to the concurrency limit. Game-thread jobs are limited by the frame budget.
+	void LaunchPendingJobs(double FrameBudgetEndTime);
+	//! run completed-job game thread updates in priority order until the frame budget is exhausted
+	void RunGameThreadUpdates(double FrameBudgetEndTime);
 
 	TArray<TSharedPtr<UGSJobSubsystem::FPendingJob>> PendingGameThreadUpdates;
 	FCriticalSection PendingGameThreadUpdatesLock;
 
+	// game thread updates that were deferred to a later tick by the frame budget (game thread only)
+	TArray<TSharedPtr<UGSJobSubsystem::FPendingJob>> DeferredGameThreadUpdates;
+
+	// updated from game thread and job tasks, protected by StatsLock
+	UGSJobSubsystem::FJobStatistics Stats;
+	mutable FCriticalSection StatsLock;
+	void UpdateStats(TFunctionRef<void(UGSJobSubsystem::FJobStatistics&)> UpdateFunc);
+
 
 	TArray<TSharedPtr<UGSJobSubsystem::FGameThreadTickJob>> PendingTickJobs;
 	FCriticalSection PendingTickJobsLock;
@@ -9,6 +9,7 @@
 #include "DynamicMesh/DynamicMesh3.h"
 #include "DynamicMesh/DynamicMeshAABBTree3.h"
 #include "TransformTypes.h"
+#include "BoxTypes.h"
 
 #include "Math/GSIntVector2.h"
 #include "Math/GSIntVector3.h"
@@ -41,8 +42,39 @@ public:
 		const TArray<GS::Vector2i>& ColumnsToUpdate,
 		TFunctionRef<void(GS::Vector2i Column, UE::Geometry::FDynamicMesh3& Mesh)> UpdateColumnMeshFunc);
 
+	/**
+	 * Build new meshes for the given columns on a background task. The existing column meshes stay
+	 * visible until PublishCompletedColumnUpdates() is called after the task has completed.
+	 * Only one batch can be in flight, returns false (and does nothing) if the previous batch has not been published yet.
+	 * UpdateColumnMeshFunc is called from multiple threads, the caller must not modify any data it reads until the batch completes.
+	 */
+	bool AsyncUpdateColumns(
+		const TArray<GS::Vector2i>& ColumnsToUpdate,
+		TFunction<void(GS::Vector2i Column, UE::Geometry::FDynamicMesh3& Mesh)> UpdateColumnMeshFunc);
+
+	//! true if an AsyncUpdateColumns() batch has not been published yet
+	bool HasPendingColumnUpdates() const { return PendingColumnBatch.IsValid(); }
+
+	/**
+	 * If the pending AsyncUpdateColumns() batch has completed, swap the new meshes into the column components.
+	 * @param bWait if true, wait for the pending batch to complete
+	 * @return true if a batch was published
+	 */
+	bool PublishCompletedColumnUpdates(bool bWait = false);
+
 	void BeginCollisionUpdate();
 
+	/**
+	 * If enabled, chunks that have not been modified for MergeDelaySeconds are moved into a 
+	 * single aggregate component for each MergeGroupSize x MergeGroupSize block of columns, to limit the number 
+	 * of components (and scene proxies/draw calls) for large grids. Modifying a merged chunk moves it back into
+	 * its own component. Merging happens in UpdateChunkMerging().
+	 */
+	void SetChunkMerging(bool bEnable, int32 MergeGroupSize = 4, double MergeDelaySeconds = 5.0);
+
+	//! merge inactive chunks into their aggregate components, if chunk merging is enabled. Intended to be called once per frame.
+	void UpdateChunkMerging();
+
 	bool FindRayIntersection(const FRay3d& WorldRay, FHitResult& HitOut);
 
 	AActor* GetPreviewActor() const;
@@ -61,22 +93,102 @@ protected:
 	struct FMeshChunk
 	{
 		GS::Vector3i ChunkIndex;
+		//! null if the chunk is empty or merged, in that case the mesh is stored in DetachedMesh
 		TWeakObjectPtr<UDynamicMeshComponent> MeshComponent;
+		UE::Geometry::FDynamicMesh3 DetachedMesh;
 		FCriticalSection MeshLock;
 
+		//! true if the chunk is drawn by the aggregate component of its merge group
+		bool bMerged = false;
+		//! FPlatformTime::Seconds() when the chunk was last modified
+		double LastModifiedTime = 0;
+
+		//! element counts and geometry hash of the mesh CollisionMesh/CollisionBVH were built from. A re-meshed
+		//! chunk that produced the same mesh skips the collision rebuild. Counts are -1 until the first build.
+		int32 CollisionVertexCount = -1;
+		int32 CollisionTriangleCount = -1;
+		uint32 CollisionMeshHash = 0;
+
 		// does it make sense to use FDynamicMesh3 here? could copy into something else...
-		bool bCollisionUpdatePending;
 		UE::Geometry::FDynamicMesh3 CollisionMesh;
 		UE::Geometry::FDynamicMeshAABBTree3 CollisionBVH;
+		//! local-space bounds of CollisionMesh, updated with the BVH
+		UE::Geometry::FAxisAlignedBox3d CollisionBounds = UE::Geometry::FAxisAlignedBox3d::Empty();
 	};
 	TMap<GS::Vector3i, TSharedPtr<FMeshChunk>> MeshChunks;
+
+	/**
+	 * Uniform 2D grid over the XY bounds of the chunk collision meshes. Each chunk is
+	 * listed in every cell its bounds overlap, so FindRayIntersection() can walk the cells
+	 * along the ray front-to-back (DDA) and stop once a hit is closer than the next cell.
+	 * Rebuilt at the end of each collision update.
+	 */
+	struct FChunkRayGrid
+	{
+		TArray<FMeshChunk*> Chunks;
+		UE::Geometry::FAxisAlignedBox3d Bounds = UE::Geometry::FAxisAlignedBox3d::Empty();
+		FVector2d Origin = FVector2d::Zero();
+		double CellSize = 1.0;
+		FIntPoint Dimensions = FIntPoint::ZeroValue;
+		//! chunk indices for cell i are CellChunks[CellStarts[i] .. CellStarts[i+1]-1]
+		TArray<int32> CellStarts;
+		TArray<int32> CellChunks;
+	};
+	FChunkRayGrid ChunkRayGrid;
+	void RebuildChunkRayGrid();
 	TArray<const UPrimitiveComponent*> VisibleComponents;
 
+	//! chunks whose mesh has been modified since the last BeginCollisionUpdate(), only these are checked for rebuild
+	TSet<FMeshChunk*> PendingCollisionChunks;
+	void MarkCollisionDirty(FMeshChunk& Chunk);
+
 	std::atomic<bool> bMeshCollisionUpdatesPending;
 	UE::Tasks::FTask PendingCollisionUpdateTask;
 	void WaitForPendingCollisionUpdates();
 
+	struct FColumnUpdateBatch
+	{
+		TArray<GS::Vector2i> Columns;
+		TArray<UE::Geometry::FDynamicMesh3> Meshes;
+	};
+	TSharedPtr<FColumnUpdateBatch> PendingColumnBatch;
+	UE::Tasks::FTask PendingColumnUpdateTask;
+
 	UDynamicMeshComponent* SpawnNewComponent();
+	FMeshChunk& FindOrCreateColumnChunk(GS::Vector2i Column);
+	//! mesh of the chunk, either in its component or DetachedMesh. Caller must hold Chunk.MeshLock if a collision update may be running.
+	UE::Geometry::FDynamicMesh3& GetChunkMesh(FMeshChunk& Chunk);
+
+	// components are recycled rather than destroyed when a chunk becomes empty or is merged.
+	// Pooled components are unregistered, so they do not have a scene proxy.
+	UPROPERTY()
+	TArray<TObjectPtr<UDynamicMeshComponent>> ComponentPool;
+	UDynamicMeshComponent* AcquireComponent();
+	void ReleaseComponent(UDynamicMeshComponent* Component);
+
+	//! make sure the chunk has its own component (unmerging it if necessary), before its mesh is replaced
+	void BeginChunkEdit(FMeshChunk& Chunk);
+	//! return the chunk component to the pool if the new mesh is empty
+	void EndChunkEdit(FMeshChunk& Chunk);
+
+	bool bEnableChunkMerging = false;
+	int32 ChunkMergeGroupSize = 4;
+	double ChunkMergeDelaySeconds = 5.0;
+
+	struct FMergeGroup
+	{
+		TWeakObjectPtr<UDynamicMeshComponent> Component;
+		TArray<FMeshChunk*> Chunks;
+		bool bModified = false;
+	};
+	TMap<FIntPoint, FMergeGroup> MergeGroups;
+	//! chunks that currently have their own component, ie candidates for merging
+	TSet<FMeshChunk*> UnmergedChunks;
+
+	FIntPoint GetMergeGroupIndex(const FMeshChunk& Chunk) const;
+	void MergeChunk(FMeshChunk& Chunk);
+	void UnmergeChunk(FMeshChunk& Chunk);
+	void RebuildModifiedMergeGroups();
 
 };
 
@@ -46,6 +46,16 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ModelGrid")
 	bool bAllowAssetGridModification = false;
 
+	/**
+	 * If this flag is true (and bClearGridBeforeRegenerate is true), OnRegenerateModelGrid() is run on a transient 
+	 * scratch grid, which is then compared with the Component grid, and only the blocks of cells that actually 
+	 * changed are copied. This means small parameter changes only re-mesh the affected part of the grid. 
+	 * Note that in this mode the TargetGrid passed to OnRegenerateModelGrid() is not the Component/Asset grid,
+	 * so the regeneration function must only use TargetGrid (and not, eg, GetGrid() on the Actor/Component).
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ModelGrid", AdvancedDisplay)
+	bool bUseGridDiffRegeneration = false;
+
 public:
 
 	/**
@@ -71,9 +81,19 @@ public:
 	 */
 	virtual void ExecuteRegenerateIfPending(bool bOverridePause = false);
 
+	bool IsRegenerationPending() const { return bRegenerationPending; }
+
 
 protected:
 	bool bRegenerationPending = false;
+	//! set bRegenerationPending and add this Actor to the GenerationSubsystem's pending set
+	void SetRegenerationPending();
+
+	// target grid for OnRegenerateModelGrid() if bUseGridDiffRegeneration is enabled
+	UPROPERTY(Transient)
+	TObjectPtr<UGSModelGrid> RegenerationScratchGrid;
+
+	void RegenerateWithGridDiff(UGSModelGrid* GridToEdit);
 
 	bool bIsRegisteredWithGenerationManager = false;
 	void RegisterWithGenerationManager();
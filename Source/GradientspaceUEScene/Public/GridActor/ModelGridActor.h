@@ -7,6 +7,7 @@
 class UDynamicMeshComponent;
 namespace GS { class ModelGrid; }
 namespace UE::Geometry { class FDynamicMesh3; }
+struct FModelGridActorChunkMesher;
 
 
 UENUM(BlueprintType)
@@ -36,6 +37,11 @@ protected:
 	UPROPERTY(Transient, DuplicateTransient, TextExportTransient, NonTransactional, SkipSerialization, Category = ModelGridActor, VisibleAnywhere, BlueprintReadOnly, meta = (ExposeFunctionCategories = "Mesh,Rendering,Physics,Components|StaticMesh", AllowPrivateAccess = "true"))
 	TObjectPtr<UDynamicMeshComponent> PreviewMeshComponent;
 
+	// visualization components for chunked preview mesh (see bUseChunkedPreviewMesh), keyed by mesh-cache column. 
+	// Same (lack of) serialization behavior as PreviewMeshComponent.
+	UPROPERTY(Transient, DuplicateTransient, TextExportTransient, NonTransactional, SkipSerialization)
+	TMap<FIntPoint, TObjectPtr<UDynamicMeshComponent>> PreviewChunkComponents;
+
 public:
 	UFUNCTION(BlueprintCallable, Category = ModelGridActor)
 	UGSModelGridComponent* GetGridComponent() const { return GridComponent; }
@@ -48,8 +54,20 @@ public:
 	UPROPERTY(Category = ModelGridActor, EditAnywhere, BlueprintReadWrite)
 	bool bEnablePreviewMesh = true;
 
+	/**
+	 * If enabled, the preview mesh is split into a separate Component for each column chunk of the grid,
+	 * and grid changes only re-mesh, re-upload and re-cook collision for the chunks in the modified region.
+	 * Otherwise the entire grid is re-meshed into a single Component on each change.
+	 */
+	UPROPERTY(Category = ModelGridActor, EditAnywhere, BlueprintReadOnly, AdvancedDisplay)
+	bool bUseChunkedPreviewMesh = true;
+
 	virtual void UpdateGridPreviewMesh(UE::Geometry::FDynamicMesh3&& PreviewMesh, TArray<UMaterialInterface*>&& Materials);
 
+	//! update the chunk Components for the given chunks. If bRemoveOtherChunks is true, all other chunk Components are destroyed.
+	virtual void UpdateGridPreviewChunks(const TArray<FIntPoint>& Chunks, TArray<UE::Geometry::FDynamicMesh3>& ChunkMeshes, 
+		bool bRemoveOtherChunks, const TArray<UMaterialInterface*>& Materials);
+
 	virtual UDynamicMeshComponent* GetPreviewMeshComponent() const { return PreviewMeshComponent; }
 
 
@@ -62,9 +80,32 @@ public:
 
 
 protected:
-	void OnModelGridChanged(UGSModelGridComponent* Component, UGSModelGrid* ModelGrid);
+	void OnModelGridChanged(UGSModelGridComponent* Component, UGSModelGrid* ModelGrid, const FModelGridChangeJournal& ChangeJournal);
 	FDelegateHandle OnModelGridChanged_Handle;
 
+	/**
+	 * Mesh rebuilds are coalesced: at most one mesh job is in flight, and changes that arrive while
+	 * it is running only set bMeshRebuildPending, so a burst of edits results in a single follow-up
+	 * rebuild. A completed mesh is always applied, even if it is already out of date, and the pending
+	 * rebuild then replaces it. PreviewGeneration increments when the preview components are destroyed,
+	 * a chunked job launched before that discards its result and a full rebuild follows.
+	 */
+	uint32 PreviewGeneration = 0;
+	bool bMeshJobInFlight = false;
+	bool bMeshRebuildPending = false;
+	virtual void LaunchMeshRebuildJob();
+	virtual void LaunchChunkedMeshRebuildJob();
+
+	//! grid changes not yet included in the chunked preview mesh
+	FModelGridChangeJournal PendingMeshChanges;
+	//! incremental mesher for chunked preview, only used by the (single) in-flight mesh job
+	TSharedPtr<FModelGridActorChunkMesher, ESPMode::ThreadSafe> ChunkMesher;
+
+	UDynamicMeshComponent* CreatePreviewMeshComponent(FName ComponentName);
+	void ConfigurePreviewMeshMaterials(UDynamicMeshComponent* Component, const TArray<UMaterialInterface*>& Materials);
+	bool HasPreviewMeshComponents() const;
+	void DestroyPreviewMeshComponents();
+
 protected:
 	virtual void PostLoad() override;
 	virtual void PostInitializeComponents() override;
@@ -80,4 +121,6 @@ protected:
 
 	virtual void UpdatePreviewMeshState();
 	virtual void UpdatePreviewMeshCollisionState();
+	virtual void UpdatePreviewMeshCollisionState(UDynamicMeshComponent* Component);
+	void UpdateAllPreviewMeshCollision();
 };
@@ -0,0 +1,51 @@
+// Copyright Gradientspace Corp. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ModelGrid/ModelGridCell.h"
+#include "Math/GSIntVector3.h"
+
+namespace GS
+{
+
+struct FModelGridCellDelta
+{
+	Vector3i CellIndex;
+	ModelGridCell Before;
+	ModelGridCell After;
+};
+
+//! field-wise comparison of two cells, a bitwise comparison of the struct would include padding bytes
+GRADIENTSPACEUESCENE_API bool IsSameModelGridCell(const ModelGridCell& A, const ModelGridCell& B);
+
+/**
+ * Compact storage for a set of cell deltas, used for undo records. Deltas are grouped into
+ * FModelGridChangeJournal::BlockSize^3 blocks, and within a block, consecutive cells (in X-fastest 
+ * order) with identical Before and After values are stored as a single run. Cell values are 
+ * stored once in CellPalette and referenced by index, so eg filling a large region with a 
+ * single cell type stores one run per block row and two palette entries.
+ */
+struct GRADIENTSPACEUESCENE_API FCompressedModelGridCellDeltas
+{
+	struct FRun
+	{
+		uint16 StartIndex = 0;		// block-local linear cell index
+		uint16 Count = 0;
+		int32 BeforeCell = 0;		// index into CellPalette
+		int32 AfterCell = 0;
+	};
+	struct FBlock
+	{
+		FIntVector BlockIndex;
+		TArray<FRun> Runs;
+	};
+	TArray<FBlock> Blocks;
+	TArray<ModelGridCell> CellPalette;
+
+	bool IsEmpty() const { return Blocks.Num() == 0; }
+
+	void Compress(TArray<FModelGridCellDelta>& Deltas);		// sorts Deltas
+	void EnumerateDeltas(TFunctionRef<void(const Vector3i& CellIndex, const ModelGridCell& Before, const ModelGridCell& After)> DeltaFunc) const;
+};
+
+}
@@ -5,7 +5,8 @@
 #include "GridActor/UGSModelGrid.h"
 #include "GridActor/UGSGridMaterialSet.h"
 #include "GridActor/UGSModelGridAsset.h"
-#include "Templates/PimplPtr.h"
+#include "Templates/SharedPointer.h"
+#include <atomic>
 
 namespace GS { class ModelGridCollider; }
 
@@ -52,11 +53,12 @@ public:
 	virtual UGSGridMaterialSet* GetGridMaterials() const;
 
 public:
-	DECLARE_MULTICAST_DELEGATE_TwoParams(FOnModelGridChanged, UGSModelGridComponent*, UGSModelGrid*);
+	//! change notification, journal is forwarded from UGSModelGrid::OnModelGridReplaced (or is a full-grid change if the active grid was swapped)
+	DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnModelGridChanged, UGSModelGridComponent*, UGSModelGrid*, const FModelGridChangeJournal&);
 	FOnModelGridChanged& OnModelGridChanged() { return ModelGridChangedEvent; }
 protected:
 	FOnModelGridChanged ModelGridChangedEvent;
-	virtual void NotifyModelGridModification(UGSModelGrid* Grid);
+	virtual void NotifyModelGridModification(UGSModelGrid* Grid, const FModelGridChangeJournal& ChangeJournal);
 
 protected:
 	/** Internal ModelGrid stored in the Component (ie as part of the Actor/Level) */
@@ -98,10 +100,39 @@ public:
 
 
 protected:
-	// todo: some kind of async support...
-	TPimplPtr<GS::ModelGridCollider> GridCollider;
+	/**
+	 * Current published collider. Colliders are never modified after they are published,
+	 * LaunchGridColliderUpdate() builds a new version on a background job and then swaps it in
+	 * on the game thread. At most one collider job is in flight, changes that arrive while it is
+	 * running are accumulated in PendingColliderChanges and the follow-up job is launched when it
+	 * completes. A completed job is always published if no full rebuild/invalidation happened since
+	 * it was launched, so continuous edits still publish (latest wins).
+	 */
+	TSharedPtr<GS::ModelGridCollider, ESPMode::ThreadSafe> GridCollider;
+	//! grid changes that are not yet included in the published GridCollider (or the in-flight job)
+	FModelGridChangeJournal PendingColliderChanges;
+	//! incremented for each collider update, a job is only published if it is newer than PublishedColliderRevision
+	std::atomic<int64> ColliderUpdateRevision = 0;
+	int64 PublishedColliderRevision = 0;
+	bool bColliderJobInFlight = false;
+	bool bColliderUpdatePending = false;
+
+	/**
+	 * The previously-published collider, and the changes it is missing relative to GridCollider. 
+	 * Incremental updates bring this collider up to date in place and publish it, rather than copying 
+	 * GridCollider (which is O(collider size)). The copy is only needed if there is no back collider 
+	 * yet, or a ProcessGridCollider() caller still holds a reference to it.
+	 */
+	TSharedPtr<GS::ModelGridCollider, ESPMode::ThreadSafe> BackGridCollider;
+	FModelGridChangeJournal BackGridColliderChanges;
+
+	//! synchronously rebuild the entire collider
 	virtual void UpdateGridCollider();
 	virtual void InvalidateGridCollider();
+	//! update the collider in the modified region of the ChangeJournal on a background job
+	virtual void LaunchGridColliderUpdate(const FModelGridChangeJournal& ChangeJournal);
+	//! launch a collider job for the current PendingColliderChanges
+	virtual void LaunchGridColliderJob();
 public:
 	UPROPERTY(Category = ModelGridComponent, EditAnywhere, BlueprintReadWrite)
 	EModelGridComponentCollisionMode GridCollisionMode = EModelGridComponentCollisionMode::NoCollision;
@@ -112,10 +143,10 @@ public:
 	virtual void ProcessGridCollider(TFunctionRef<void(const GS::ModelGridCollider&)> ProcessFunc) const;
 
 protected:
-	void OnLocalModelGridUpdated(UGSModelGrid* ModelGrid);
+	void OnLocalModelGridUpdated(UGSModelGrid* ModelGrid, const FModelGridChangeJournal& ChangeJournal);
 	FDelegateHandle OnLocalModelGridUpdated_Handle;
 
-	void OnModelGridAssetUpdated(UGSModelGrid* ModelGrid);
+	void OnModelGridAssetUpdated(UGSModelGrid* ModelGrid, const FModelGridChangeJournal& ChangeJournal);
 	FDelegateHandle OnModelGridAssetUpdated_Handle;
 
 	TWeakObjectPtr<UGSModelGridAsset> LastTargetAsset;
@@ -132,6 +163,8 @@ protected:
 	//! PostEditImport is called after editor T3D-based copy-paste/duplicate/import - PostDuplicate is *not* called on Components, but this is
 	virtual void PostEditImport() override;
 
+	virtual void BeginDestroy() override;
+
 public:
 	// TODO WORKAROUND - this is a function that external code (eg Actor) can use to 
 	// force this Component to start listening to an assigned GridObjectAsset after a duplication,
@@ -29,6 +29,11 @@ struct GRADIENTSPACEUESCENE_API FGSGridMaterialID
 	{
 		return ReferenceType == OtherID.ReferenceType && Index == OtherID.Index;
 	}
+
+	friend uint32 GetTypeHash(const FGSGridMaterialID& ID)
+	{
+		return HashCombine(::GetTypeHash(ID.ReferenceType), ::GetTypeHash(ID.Index));
+	}
 };
 
 
@@ -132,6 +137,17 @@ protected:
 
 	void UpdateReferenceSet();
 
+	// hashed indices into ExternalMaterials, rebuilt by UpdateReferenceSet() (ie on load, property edit and undo). 
+	// ExternalMaterials is also BP-writable, so lookups rebuild the maps if the array size no longer matches 
+	// IndexedMaterialCount or a found entry no longer matches. A miss on up-to-date maps is a real miss.
+	TMap<const UMaterialInterface*, int32> MaterialToIndexMap;
+	TMap<FGSGridMaterialID, int32> MaterialIDToIndexMap;
+	int32 IndexedMaterialCount = 0;
+	void UpdateMaterialIndexMaps();
+	void AddToMaterialIndexMaps(int32 Index);
+	int32 FindExternalMaterialIndex(const UMaterialInterface* Material);
+	int32 FindExternalMaterialIndex(FGSGridMaterialID GridMaterialID);
+
 	virtual void PostLoad() override;
 #if WITH_EDITOR
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
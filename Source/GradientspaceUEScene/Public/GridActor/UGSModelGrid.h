@@ -2,11 +2,53 @@
 #pragma once
 
 #include "UObject/Object.h"
-#include "HAL/CriticalSection.h"
-#include "Templates/PimplPtr.h"
+#include "Misc/ScopeRWLock.h"
+#include "Templates/SharedPointer.h"
 #include "UGSModelGrid.generated.h"
 
 namespace GS { class ModelGrid; }
+class FModelGridCellDeltaChange;
+
+
+/**
+ * Accumulated record of the grid cells modified by EditGrid() calls since the last change
+ * notification. Delivered with UGSModelGrid::OnModelGridReplaced() so that listeners can
+ * limit updates to the modified region. If the modified region is not known (eg EditGrid()
+ * was called without a region, the grid was loaded/replaced/undone), bFullGridChanged is set.
+ * 
+ * Cells are also grouped into fixed-size blocks of BlockSize^3 cells. Note that modifying a cell
+ * can affect the mesh of adjacent cells, listeners may need to expand the region by one cell.
+ */
+struct FModelGridChangeJournal
+{
+	static constexpr int32 BlockSize = 16;
+	//! if more blocks than this are modified, only the bounds are tracked and ModifiedBlocks is cleared
+	static constexpr int32 MaxTrackedBlocks = 4096;
+
+	bool bFullGridChanged = false;
+
+	//! inclusive bounds of modified cells, only valid if bHasModifiedCells is true
+	bool bHasModifiedCells = false;
+	FIntVector ModifiedCellMin = FIntVector::ZeroValue;
+	FIntVector ModifiedCellMax = FIntVector::ZeroValue;
+
+	//! indices of modified blocks (CellIndex / BlockSize, rounded down). Empty if bBlocksOverflowed.
+	TSet<FIntVector> ModifiedBlocks;
+	bool bBlocksOverflowed = false;
+
+	bool IsEmpty() const { return bFullGridChanged == false && bHasModifiedCells == false; }
+	//! true if the journal does not identify a finite set of modified cells
+	bool IsFullGridChange() const { return bFullGridChanged; }
+
+	GRADIENTSPACEUESCENE_API void AddModifiedCells(const FIntVector& MinCell, const FIntVector& MaxCell);
+	GRADIENTSPACEUESCENE_API void AddFullGridChange();
+	GRADIENTSPACEUESCENE_API void Append(const FModelGridChangeJournal& OtherJournal);
+	GRADIENTSPACEUESCENE_API void Reset();
+
+	GRADIENTSPACEUESCENE_API static FIntVector GetBlockIndex(const FIntVector& CellIndex);
+	GRADIENTSPACEUESCENE_API static FModelGridChangeJournal MakeFullGridChange();
+};
+
 
 UCLASS(BlueprintType, MinimalAPI)
 class UGSModelGrid : public UObject
@@ -20,28 +62,81 @@ public:
 	GRADIENTSPACEUESCENE_API
 	void SetEnableTransactions(bool bEnable);
 
+	/**
+	 * If enabled (default), undo transactions for this grid store only the cells modified by
+	 * each outer EditGrid() call or BeginGridEdits/EndGridEdits scope, rather than serializing
+	 * the entire grid into the transaction buffer. Only relevant if transactions are enabled.
+	 */
+	GRADIENTSPACEUESCENE_API
+	void SetUseDeltaTransactions(bool bEnable);
+
 
 public:
-	//! Access the internal ModelGrid for reading. This function locks the grid, and so is safe to call from multiple threads.
+	//! Access the internal ModelGrid for reading. This function takes a shared (read) lock on the grid, so multiple readers can run concurrently.
 	GRADIENTSPACEUESCENE_API
 	virtual void ProcessGrid( TFunctionRef<void(const GS::ModelGrid& Grid)> ProcessFunc );
 
-	//! Edit the internal ModelGrid. This function locks the grid, and so is safe to call from multiple threads.
+	//! Edit the internal ModelGrid. This function takes an exclusive (write) lock on the grid, and so is safe to call from multiple threads.
 	GRADIENTSPACEUESCENE_API
 	virtual void EditGrid( 
 		TFunctionRef<void(GS::ModelGrid& Grid)> EditFunc,
 		bool bDeferUpdateNotification = false);
 
-	//! removes all cells from current grid - implemented via EditGrid
+	/**
+	 * Same as EditGrid(), but the caller guarantees that only cells inside the (inclusive) cell 
+	 * index range [MinCell,MaxCell] are modified. The region is recorded in the change journal, 
+	 * otherwise EditGrid() must assume the entire grid has changed.
+	 */
+	GRADIENTSPACEUESCENE_API
+	virtual void EditGridRegion(
+		const FIntVector& MinCell, const FIntVector& MaxCell,
+		TFunctionRef<void(GS::ModelGrid& Grid)> EditFunc,
+		bool bDeferUpdateNotification = false);
+
+	//! removes all cells from current grid. The grid is replaced rather than edited, so this does not trigger a copy-on-write.
 	GRADIENTSPACEUESCENE_API
 	virtual void ResetGrid(bool bDeferUpdateNotification = false);
 
+	/**
+	 * Returns an immutable snapshot of the current grid. Taking a snapshot is O(1), the snapshot shares
+	 * the grid storage with this UGSModelGrid. However if any snapshots are still alive, the next
+	 * EditGrid() makes a full copy of the grid before editing it (copy-on-write, shows up as
+	 * UGSModelGrid::CopyOnWrite in a trace), so a snapshot never changes. For large grids that copy
+	 * can cost much more than the edit itself, so background jobs should take the snapshot when they 
+	 * start running (not when they are queued) and release it as soon as they have read the grid.
+	 */
+	GRADIENTSPACEUESCENE_API
+	virtual TSharedPtr<const GS::ModelGrid> GetGridSnapshot();
+
+	/**
+	 * Update this grid to match SourceGrid. The two grids are compared in blocks of
+	 * FModelGridChangeJournal::BlockSize^3 cells, and only blocks that differ are copied
+	 * (via EditGridRegion), so listeners only see the modified blocks in the change journal.
+	 * If the cell dimensions differ, the entire grid is replaced.
+	 * @return number of modified blocks, or -1 if the entire grid was replaced
+	 */
+	GRADIENTSPACEUESCENE_API
+	virtual int32 UpdateModifiedBlocksFromGrid(const GS::ModelGrid& SourceGrid, bool bDeferUpdateNotification = false);
+
+	/**
+	 * Same as UpdateModifiedBlocksFromGrid() above, but only the blocks in CandidateBlocks (see FModelGridChangeJournal::GetBlockIndex)
+	 * are compared. The caller guarantees that all cells outside these blocks are identical in the two grids.
+	 */
+	GRADIENTSPACEUESCENE_API
+	virtual int32 UpdateModifiedBlocksFromGrid(const GS::ModelGrid& SourceGrid, const TSet<FIntVector>& CandidateBlocks, bool bDeferUpdateNotification = false);
+
 public:
-	DECLARE_MULTICAST_DELEGATE_OneParam(FOnModelGridReplaced, UGSModelGrid*);
+	//! Change notification. The journal contains all modifications since the previous notification.
+	DECLARE_MULTICAST_DELEGATE_TwoParams(FOnModelGridReplaced, UGSModelGrid*, const FModelGridChangeJournal&);
 	FOnModelGridReplaced& OnModelGridReplaced() { return ModelGridReplacedEvent; }
 protected:
 	FOnModelGridReplaced ModelGridReplacedEvent;
 
+	// modifications since last ModelGridReplacedEvent, protected by GridLock
+	FModelGridChangeJournal PendingChangeJournal;
+	//! take the PendingChangeJournal and broadcast ModelGridReplacedEvent
+	GRADIENTSPACEUESCENE_API void BroadcastGridChanged(bool bFullGridChanged = false);
+
 
 public:
 	/**
@@ -74,19 +169,55 @@ public:
 
 
 protected:
-	TPimplPtr<GS::ModelGrid> Grid;
-	FCriticalSection GridLock;
+	// shared with snapshots returned by GetGridSnapshot(). EditGridInternal() copies the grid if it is not unique.
+	TSharedPtr<GS::ModelGrid> Grid;
+
+	/**
+	 * Shared/Exclusive lock for Grid. FRWLock is not recursive, so AcquireGridLock() tracks
+	 * the locks held by the current thread, and nested ProcessGrid/EditGrid calls on the same
+	 * grid pass through (this was supported by the previous FCriticalSection)
+	 */
+	FRWLock GridLock;
+
+	enum class EGridLockResult : uint8
+	{
+		Acquired,
+		AlreadyHeld,
+		UpgradedFromRead
+	};
+	GRADIENTSPACEUESCENE_API EGridLockResult AcquireGridLock(bool bWriteLock);
+	GRADIENTSPACEUESCENE_API void ReleaseGridLock(EGridLockResult LockResult, bool bWriteLock);
 
 
 	bool bEnableTransactions = false;
+	bool bUseDeltaTransactions = true;
+
+	// undo state of the current outer edit scope, ie the previous values of the cells in the edited regions. Defined in the .cpp.
+	struct FDeltaTransactionState;
+	TSharedPtr<FDeltaTransactionState> DeltaTransaction;
+	bool ShouldRecordDeltaTransaction() const;
+	void BeginDeltaTransaction();
+	void EndDeltaTransaction();
+	//! store the current values of the cells in [MinCell,MaxCell] (or the entire grid if no range is given) before they are edited. 
+	//! Grid lock must be held. bEditInPlace indicates that the Grid will be modified without a copy-on-write (ie nested edits).
+	void CaptureDeltaTransactionCells(const FIntVector* MinCell, const FIntVector* MaxCell, bool bEditInPlace);
+	friend class FModelGridCellDeltaChange;
 
 	std::atomic<int32> GridEditCounter = 0;
 	std::atomic<int32> GridEditStackDepth = 0;
 	std::atomic<int32> InitialGridEditCounter;		// set on BeginGridEdits
 
-	//! allows editing grid but does not post any notifications/etc
+	//! allows editing grid but does not post any notifications/etc. If the modified cell range is not provided, the change journal records a full-grid change.
 	GRADIENTSPACEUESCENE_API
-	virtual void EditGridInternal(TFunctionRef<void(GS::ModelGrid& Grid)> EditFunc);
+	virtual void EditGridInternal(TFunctionRef<void(GS::ModelGrid& Grid)> EditFunc, 
+		const FIntVector* ModifiedCellMin = nullptr, const FIntVector* ModifiedCellMax = nullptr);
+
+	void EditGridWithNotification(TFunctionRef<void(GS::ModelGrid& Grid)> EditFunc, 
+		const FIntVector* ModifiedCellMin, const FIntVector* ModifiedCellMax, bool bDeferUpdateNotification);
+
+	//! compare the candidate blocks (clipped to the inclusive cell range [ClipMin,ClipMax]) with SourceGrid and copy the ones that differ
+	int32 UpdateBlocksFromGridInternal(const GS::ModelGrid& SourceGrid, const TArray<FIntVector>& CandidateBlocks, 
+		const FIntVector& ClipMin, const FIntVector& ClipMax, bool bDeferUpdateNotification);
 
 public:
 	GRADIENTSPACEUESCENE_API virtual void Serialize(FArchive& Archive) override;
@@ -6,6 +6,8 @@
 
 #include "GSMeshComponent.generated.h"
 
+namespace GS { class FMeshRenderBuffers; }
+
 /**
  * Gradientspace Mesh Component
  */
@@ -35,11 +37,35 @@ protected:
 	bool bUseDynamicDrawPath = false;
 
 
+public:
+	/**
+	 * If enabled, render buffers for an edited mesh are built on a background task, and
+	 * the existing SceneProxy stays visible until the new buffers are ready. Only the RHI upload
+	 * happens on the render thread. If disabled, buffers are built when the SceneProxy is (re)created.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gradientspace Mesh")
+	bool bBuildRenderBuffersAsync = true;
+
 protected:
-	TUniquePtr<GS::DenseMesh> Mesh;
+	// shared with in-flight render buffer jobs, EditMesh() makes a copy if a job still holds a reference
+	TSharedPtr<GS::DenseMesh> Mesh;
 	FBox LocalBounds;
 
+	// incremented on each EditMesh(). Only accessed on the game thread, jobs carry their own copy.
+	int64 RenderBufferRevision = 0;
+	// revision of the buffers in ReadyRenderBuffers/SceneProxy, job results that are not newer than this are discarded
+	int64 DisplayedRenderBufferRevision = 0;
+	// buffers built by a background job, waiting to be handed to the next SceneProxy
+	GS::FMeshRenderBuffers* ReadyRenderBuffers = nullptr;
+
+	virtual void LaunchRenderBufferBuild();
+	virtual void OnRenderBuffersBuilt(GS::FMeshRenderBuffers* NewRenderBuffers, int64 Revision);
+	void ReleaseReadyRenderBuffers();
+
 protected:
+	// UObject Interface
+	virtual void BeginDestroy() override;
+
 	// UPrimitiveComponent Interface
 	virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
 
@@ -10,6 +10,7 @@
 #include "ToolDataVisualizer.h"
 #include "Selection/ToolSelectionUtil.h"
 #include "PreviewMesh.h"
+#include "Drawing/PointSetComponent.h"
 
 #include "Mechanics/ConstructionPlaneMechanic.h"
 #include "Mechanics/DragAlignmentMechanic.h"
@@ -21,12 +22,14 @@
 #include "Core/DynamicMeshGenericAPI.h"
 
 #include "GridActor/ModelGridActor.h"
+#include "GridActor/ModelGridCellDeltas.h"
 #include "Color/GSColor3b.h"
 #include "ModelGrid/ModelGridCell.h"
 #include "ModelGrid/ModelGridUtil.h"
 #include "ModelGrid/ModelGrid.h"
 #include "ModelGrid/ModelGridEditor.h"
 #include "ModelGrid/ModelGridEditMachine.h"
+#include "Grid/GSGridUtil.h"
 #include "ModelGrid/ModelGridMeshCache.h"
 #include "ModelGrid/ModelGridCollision.h"
 #include "ModelGrid/ModelGridSerializer.h"
@@ -64,18 +67,20 @@ static const int UModelGridEditorTool_ShiftModifier = 1;
 static const int UModelGridEditorTool_CtrlModifier = 2;
 
 
+/**
+ * Undo record for a single tracked edit (eg a stroke). The cells modified by the EditSM tracked change 
+ * are stored as compressed before/after deltas (see FCompressedModelGridCellDeltas), rather than keeping 
+ * the GS::ModelGridDeltaChange, which stores every modified cell individually.
+ */
 class FModelGrid_GridDeltaChange : public FToolCommandChange
 {
 public:
-	std::unique_ptr<GS::ModelGridDeltaChange> GridChange;
+	GS::FCompressedModelGridCellDeltas CellDeltas;
 	virtual void Apply(UObject* Object) override;
 	virtual void Revert(UObject* Object) override;
 	virtual FString ToString() const override { return TEXT("FModelGrid_GridDeltaChange"); }
-
-	virtual ~FModelGrid_GridDeltaChange() {
-		if (GridChange)
-			GS::ModelGridDeltaChange::DeleteChangeFromExternalDLL(GridChange.release());
-	}
+protected:
+	void ApplyToTool(UObject* Object, bool bRevert);
 };
 
 
@@ -110,6 +115,96 @@ UModelGridEditorTool* UModelGridEditorToolBuilder::CreateNewToolOfType(const FTo
 
 
 
+/**
+ * Sparse set of modified cell regions, stored as a short list of disjoint boxes. Boxes that
+ * overlap or touch are merged. If the list grows past MaxBoxes, the new box is merged into the
+ * box whose volume grows least. This way two small edits at opposite ends of the grid do not
+ * become an update of the entire box between them. Boxes are snapped outwards to block bounds 
+ * (FModelGridChangeJournal::BlockSize) before merging, so disjoint boxes never share a block, and 
+ * updating each box does not re-process a block that another box also touches.
+ */
+struct FModelGridDirtyRegions
+{
+	static constexpr int MaxBoxes = 32;
+	TArray<AxisBox3i, TInlineAllocator<8>> Boxes;
+
+	bool IsEmpty() const { return Boxes.Num() == 0; }
+	void Reset() { Boxes.Reset(); }
+
+	void Add(AxisBox3i NewBox)
+	{
+		if (NewBox.IsValid() == false)
+			return;
+		NewBox = SnapToBlocks(NewBox);
+
+		// absorb any boxes that overlap or are adjacent to NewBox, until it is disjoint from all of them
+		bool bMerged = true;
+		while (bMerged)
+		{
+			bMerged = false;
+			for (int k = 0; k < Boxes.Num(); ++k)
+			{
+				if (IsOverlappingOrAdjacent(Boxes[k], NewBox))
+				{
+					NewBox = GetUnion(Boxes[k], NewBox);
+					Boxes.RemoveAtSwap(k);
+					bMerged = true;
+					break;
+				}
+			}
+		}
+
+		if (Boxes.Num() < MaxBoxes)
+		{
+			Boxes.Add(NewBox);
+			return;
+		}
+
+		int BestIndex = 0;
+		int64 BestGrowth = TNumericLimits<int64>::Max();
+		for (int k = 0; k < Boxes.Num(); ++k)
+		{
+			int64 Growth = GetVolume(GetUnion(Boxes[k], NewBox)) - GetVolume(Boxes[k]);
+			if (Growth < BestGrowth)
+			{
+				BestGrowth = Growth;
+				BestIndex = k;
+			}
+		}
+		AxisBox3i MergedBox = GetUnion(Boxes[BestIndex], NewBox);
+		Boxes.RemoveAtSwap(BestIndex);
+		Add(MergedBox);		// merged box may now overlap other boxes
+	}
+
+	static AxisBox3i SnapToBlocks(const AxisBox3i& Box)
+	{
+		const int BlockSize = FModelGridChangeJournal::BlockSize;
+		FIntVector MinBlock = FModelGridChangeJournal::GetBlockIndex(FIntVector(Box.Min.X, Box.Min.Y, Box.Min.Z));
+		FIntVector MaxBlock = FModelGridChangeJournal::GetBlockIndex(FIntVector(Box.Max.X, Box.Max.Y, Box.Max.Z));
+		return AxisBox3i(
+			Vector3i(MinBlock.X * BlockSize, MinBlock.Y * BlockSize, MinBlock.Z * BlockSize),
+			Vector3i((MaxBlock.X + 1) * BlockSize - 1, (MaxBlock.Y + 1) * BlockSize - 1, (MaxBlock.Z + 1) * BlockSize - 1));
+	}
+	static bool IsOverlappingOrAdjacent(const AxisBox3i& A, const AxisBox3i& B)
+	{
+		return A.Min.X <= B.Max.X + 1 && B.Min.X <= A.Max.X + 1
+			&& A.Min.Y <= B.Max.Y + 1 && B.Min.Y <= A.Max.Y + 1
+			&& A.Min.Z <= B.Max.Z + 1 && B.Min.Z <= A.Max.Z + 1;
+	}
+	static AxisBox3i GetUnion(const AxisBox3i& A, const AxisBox3i& B)
+	{
+		AxisBox3i Result = A;
+		Result.Contain(B.Min);
+		Result.Contain(B.Max);
+		return Result;
+	}
+	static int64 GetVolume(const AxisBox3i& Box)
+	{
+		return (int64)(Box.Max.X - Box.Min.X + 1) * (int64)(Box.Max.Y - Box.Min.Y + 1) * (int64)(Box.Max.Z - Box.Min.Z + 1);
+	}
+};
+
+
 // todo: work on getting rid of this class...
 class FModelGridInternal
 {
@@ -127,8 +222,11 @@ public:
 
 	ModelGridCollider Collider;
 
-	AxisBox3i PendingMeshUpdateRegion;
-	AxisBox3i PendingColliderUpdateRegion;
+	FModelGridDirtyRegions PendingMeshUpdateRegions;
+	FModelGridDirtyRegions PendingColliderUpdateRegions;
+
+	// all regions modified since the tool started, used to only commit modified blocks on Accept
+	FModelGridDirtyRegions SessionModifiedRegions;
 
 	FModelGridInternal()
 	{
@@ -145,10 +243,19 @@ public:
 			MeshCache.SetMaterialMap(GridMaterialMap);
 		MeshCache.bIncludeAllBlockBorderFaces = true;
 
-		PendingMeshUpdateRegion = Builder.GetModifiedRegionBounds(0);
+		PendingMeshUpdateRegions.Reset();
+		PendingMeshUpdateRegions.Add(Builder.GetModifiedRegionBounds(0));
 
 		Collider.Initialize(Builder);
-		PendingColliderUpdateRegion = Builder.GetModifiedRegionBounds(0);
+		PendingColliderUpdateRegions.Reset();
+		PendingColliderUpdateRegions.Add(Builder.GetModifiedRegionBounds(0));
+	}
+
+	void AddModifiedRegion(const AxisBox3i& ModifiedRegion)
+	{
+		PendingMeshUpdateRegions.Add(ModifiedRegion);
+		PendingColliderUpdateRegions.Add(ModifiedRegion);
+		SessionModifiedRegions.Add(ModifiedRegion);
 	}
 
 	void AccumulateMeshUpdateRegion()
@@ -158,15 +265,30 @@ public:
 		{
 			if (DirtyRegion.ModifiedRegion != AxisBox3i::Empty())
 			{
-				PendingMeshUpdateRegion.Contain(DirtyRegion.ModifiedRegion.Min);
-				PendingMeshUpdateRegion.Contain(DirtyRegion.ModifiedRegion.Max);
-
-				PendingColliderUpdateRegion.Contain(DirtyRegion.ModifiedRegion.Min);
-				PendingColliderUpdateRegion.Contain(DirtyRegion.ModifiedRegion.Max);
+				AddModifiedRegion(DirtyRegion.ModifiedRegion);
 			}
 		}
 	}
 
+	/**
+	 * Convert a tracked change into compressed cell deltas. The change stores the before and after value 
+	 * of each modified cell, so this is O(modified cells) and does not need to touch the grid.
+	 */
+	static void CompressTrackedChange(const GS::ModelGridDeltaChange& GridChange, GS::FCompressedModelGridCellDeltas& CellDeltasOut)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(ModelGridEditorTool_CompressTrackedChange);
+
+		const int32 NumCells = (int32)GridChange.CellKeys.size();
+		TArray<GS::FModelGridCellDelta> Deltas;
+		Deltas.Reserve(NumCells);
+		for (int32 k = 0; k < NumCells; ++k)
+		{
+			if (GS::IsSameModelGridCell(GridChange.CellsBefore[k], GridChange.CellsAfter[k]) == false)
+				Deltas.Add(GS::FModelGridCellDelta{ GridChange.CellKeys[k], GridChange.CellsBefore[k], GridChange.CellsAfter[k] });
+		}
+		CellDeltasOut.Compress(Deltas);
+	}
+
 	FVector GetHitFaceNormalForCell(FRay Ray, bool bIsWorldRay, Vector3i CellKey)
 	{
 		Ray3d LocalRay = (bIsWorldRay) ?
@@ -234,6 +356,16 @@ void UModelGridEditorTool::Setup()
 
 	PreviewGeometry = NewObject<UGSModelGridPreview>(this);
 	PreviewGeometry->Initialize(this, GetTargetWorld());
+	// columns that are not being edited are merged into larger components to limit draw calls on large grids
+	PreviewGeometry->SetChunkMerging(true);
+
+	// attached to the preview actor, so points are in grid-local coordinates
+	AActor* PreviewActor = PreviewGeometry->GetPreviewActor();
+	DrawPreviewCellsComponent = NewObject<UPointSetComponent>(PreviewActor);
+	DrawPreviewCellsComponent->SetupAttachment(PreviewActor->GetRootComponent());
+	DrawPreviewCellsComponent->SetPointMaterial(ToolSetupUtil::GetDefaultPointComponentMaterial(GetToolManager(), /*bDepthTested=*/false));
+	DrawPreviewCellsComponent->RegisterComponent();
+	DrawPreviewCellsComponent->SetVisibility(false);
 
 	if (UMaterial* GridMaterial = LoadObject<UMaterial>(nullptr, TEXT("/GradientspaceUEToolbox/Materials/M_GridEditMaterial")))	{
 		ActiveMaterial = UMaterialInstanceDynamic::Create(GridMaterial, this);
@@ -453,7 +585,7 @@ void UModelGridEditorTool::Setup()
 
 	bPreviewMeshDirty = true;
 	GridTimestamp = 0;
-	ValidatePreviewMesh();
+	ValidatePreviewMesh(true);
 	PreviewGeometry->BeginCollisionUpdate();
 	UpdateCollider();
 
@@ -721,6 +853,9 @@ void UModelGridEditorTool::Shutdown(EToolShutdownType ShutdownType)
 	DrawPreviewMesh->Disconnect();
 	DrawPreviewMesh = nullptr;
 
+	// owned by the preview actor, destroyed in PreviewGeometry->Shutdown()
+	DrawPreviewCellsComponent = nullptr;
+
 	DragAlignmentMechanic->Shutdown();
 	DragAlignmentMechanic = nullptr;
 	PlaneMechanic->Shutdown();
@@ -757,10 +892,19 @@ void UModelGridEditorTool::Shutdown(EToolShutdownType ShutdownType)
 				UpdateActor->Modify();
 				GridWrapper->Modify();
 
-				GridWrapper->EditGrid([&](ModelGrid& EditGrid)
+				// only copy blocks that were touched during the session. With delta transactions
+				// enabled on the grid, the transaction stores only the modified cells.
+				TSet<FIntVector> ModifiedBlocks;
+				for (const AxisBox3i& Region : Internal->SessionModifiedRegions.Boxes)
 				{
-					EditGrid = Internal->Builder;
-				});
+					FIntVector MinBlock = FModelGridChangeJournal::GetBlockIndex(FIntVector(Region.Min.X, Region.Min.Y, Region.Min.Z));
+					FIntVector MaxBlock = FModelGridChangeJournal::GetBlockIndex(FIntVector(Region.Max.X, Region.Max.Y, Region.Max.Z));
+					for (int32 bz = MinBlock.Z; bz <= MaxBlock.Z; ++bz)
+						for (int32 by = MinBlock.Y; by <= MaxBlock.Y; ++by)
+							for (int32 bx = MinBlock.X; bx <= MaxBlock.X; ++bx)
+								ModifiedBlocks.Add(FIntVector(bx, by, bz));
+				}
+				GridWrapper->UpdateModifiedBlocksFromGrid(Internal->Builder, ModifiedBlocks);
 
 				UpdateActor->SetActorTransform( ((FFrame3d)Internal->GridFrame).ToFTransform() );
 
@@ -999,14 +1143,13 @@ void UModelGridEditorTool::UpdateGridFrame(const UE::Geometry::FFrame3d& Frame)
 
 void UModelGridEditorTool::UpdateCollider()
 {
-	if (Internal->PendingColliderUpdateRegion.IsValid())
+	for (const AxisBox3i& ModifiedCellBounds : Internal->PendingColliderUpdateRegions.Boxes)
 	{
-		AxisBox3i ModifiedCellBounds = Internal->PendingColliderUpdateRegion;
 		AxisBox3d UpdateBox = Internal->Builder.GetCellLocalBounds(ModifiedCellBounds.Min);
 		UpdateBox.Contain(Internal->Builder.GetCellLocalBounds(ModifiedCellBounds.Max));
 		Internal->Collider.UpdateInBounds(Internal->Builder, UpdateBox);
-		Internal->PendingColliderUpdateRegion = AxisBox3i::Empty();
 	}
+	Internal->PendingColliderUpdateRegions.Reset();
 }
 
 
@@ -1015,17 +1158,23 @@ void UModelGridEditorTool::OnColumnsModified(const TArray<GS::Vector2i>& Columns
 {
 	if (Columns.Num() == 0) return;
 
-	PreviewGeometry->ParallelUpdateColumns(Columns, [&](GS::Vector2i Column, FDynamicMesh3& Mesh) {
+	// MeshCache is not modified while the batch is pending, see ValidatePreviewMesh()
+	FModelGridInternal* InternalPtr = Internal.Get();
+	PreviewGeometry->AsyncUpdateColumns(Columns, [InternalPtr](GS::Vector2i Column, FDynamicMesh3& Mesh) {
 		FDynamicMesh3Collector MeshAccumulator(&Mesh, true, true);
-		Internal->MeshCache.ExtractColumnMesh_Async(Column, MeshAccumulator);
+		InternalPtr->MeshCache.ExtractColumnMesh_Async(Column, MeshAccumulator);
 	});
 }
 
 
 static FDateTime LastHideTimeHACK;
 
-void UModelGridEditorTool::ValidatePreviewMesh()
+void UModelGridEditorTool::ValidatePreviewMesh(bool bWaitForColumnUpdates)
 {
+	// previous column meshes stay visible until the background extraction has finished
+	PreviewGeometry->PublishCompletedColumnUpdates(bWaitForColumnUpdates);
+	PreviewGeometry->UpdateChunkMerging();
+
 	// handle draw preview mesh (preview of placed cell). should not be
 	// done here, should not be done every frame, etc etc
 	bool bShowDrawPreview =
@@ -1052,23 +1201,37 @@ void UModelGridEditorTool::ValidatePreviewMesh()
 	}
 
 
-	if (bPreviewMeshDirty)
+	// the MeshCache cannot be updated while a column extraction batch is reading it, try again next tick
+	if (bPreviewMeshDirty && PreviewGeometry->HasPendingColumnUpdates() == false)
 	{
 		TArray<Vector2i> ColumnsToUpdate;
-		if (Internal->PendingMeshUpdateRegion.IsValid())
+		if (Internal->PendingMeshUpdateRegions.IsEmpty() == false)
 		{
-			AxisBox3i ModifiedCellBounds = Internal->PendingMeshUpdateRegion;
-			AxisBox3d UpdateBox = Internal->Builder.GetCellLocalBounds(ModifiedCellBounds.Min);
-			UpdateBox.Contain(Internal->Builder.GetCellLocalBounds(ModifiedCellBounds.Max));
-
-			Internal->MeshCache.UpdateInBounds(Internal->Builder, UpdateBox, 
-				[&](Vector2i Column) { ColumnsToUpdate.Add(Column); });
+			// separate regions may touch the same column, only re-extract it once
+			TSet<FIntPoint> UniqueColumns;
+			for (const AxisBox3i& ModifiedCellBounds : Internal->PendingMeshUpdateRegions.Boxes)
+			{
+				AxisBox3d UpdateBox = Internal->Builder.GetCellLocalBounds(ModifiedCellBounds.Min);
+				UpdateBox.Contain(Internal->Builder.GetCellLocalBounds(ModifiedCellBounds.Max));
+
+				Internal->MeshCache.UpdateInBounds(Internal->Builder, UpdateBox,
+					[&](Vector2i Column) {
+						bool bAlreadyInSet = false;
+						UniqueColumns.Add(FIntPoint(Column.X, Column.Y), &bAlreadyInSet);
+						if (bAlreadyInSet == false)
+							ColumnsToUpdate.Add(Column);
+					});
+			}
 
-			Internal->PendingMeshUpdateRegion = AxisBox3i::Empty();
+			Internal->PendingMeshUpdateRegions.Reset();
 		}
 
 		if (ColumnsToUpdate.Num() > 0)
+		{
 			OnColumnsModified(ColumnsToUpdate);
+			if (bWaitForColumnUpdates)
+				PreviewGeometry->PublishCompletedColumnUpdates(true);
+		}
 
 		PreviewGeometry->SetWorldTransform( ((FFrame3d)Internal->GridFrame).ToFTransform());
 
@@ -1128,6 +1291,7 @@ void UModelGridEditorTool::OnTick(float DeltaTime)
 		if (bHovering && bHaveValidHoverCell)
 			UpdateDrawPreviewVisualization();
 	}
+	UpdateDrawPreviewCellsComponent();
 
 	PlaneMechanic->PlaneTransformGizmo->SetVisibility(MiscSettings->bShowGizmo);
 
@@ -1226,23 +1390,7 @@ void UModelGridEditorTool::Render(IToolsContextRenderAPI* RenderAPI)
 		Draw.PopTransform();
 	}
 
-	// draw preview of potentially-affected cells. this is not very nice but it works for now.
-	// should probably be refactored into the Interaction somehow...
-	if (bHovering && bHaveValidHoverCell && DrawPreviewCells.size() > 0)
-	{
-		Vector3i HoverCell = ActiveHoverCellIndex;
-		Vector3d DrawPlaneOffset = -Internal->EditSM.GetActiveDrawPlaneNormal() * Internal->Builder.GetCellDimensions() * 0.5;
-		if ( InModifyExistingOperationMode() )
-			DrawPlaneOffset = -DrawPlaneOffset;
-		if (ModelSettings->DrawMode == EModelGridDrawMode::FloodFill2D || ModelSettings->DrawMode == EModelGridDrawMode::Brush2D || ModelSettings->DrawMode == EModelGridDrawMode::Brush3D || ModelSettings->DrawMode == EModelGridDrawMode::Rect2D)
-			DrawPlaneOffset = Vector3d::Zero();
-		FLinearColor PreviewColor = (ModelSettings->EditType == EModelGridDrawEditType::Erase || bCtrlToggle) ? FLinearColor(0.0f, 0.0f, 0.0f) : FLinearColor(0.95f, 0.1f, 0.0f);
-		for (Vector3i CellIndex : DrawPreviewCells) {
-			AxisBox3d CellBox = Internal->Builder.GetCellLocalBounds(CellIndex);
-			//Draw.DrawWireBox((FBox)CellBox, FLinearColor::Gray, 0.5f, true);
-			Draw.DrawPoint(CellBox.Center()+DrawPlaneOffset, PreviewColor, 2.0f, false);
-		}
-	}
+	// preview of potentially-affected cells is drawn by DrawPreviewCellsComponent, see UpdateDrawPreviewCellsComponent()
 
 	Draw.PopTransform();
 
@@ -1303,10 +1451,15 @@ void UModelGridEditorTool::EndGridChange()
 	check(Internal->EditSM.IsTrackingChange());
 	if (Internal->EditSM.IsTrackingChange())
 	{
-		TUniquePtr<FModelGrid_GridDeltaChange> DeltaChange = MakeUnique<FModelGrid_GridDeltaChange>();
-		DeltaChange->GridChange = std::move(Internal->EditSM.EndTrackedChange());
-		if (DeltaChange->GridChange) 
-			GetToolManager()->EmitObjectChange(this, MoveTemp(DeltaChange), LOCTEXT("ModelGrid_ModelEdit", "Edit Grid"));
+		std::unique_ptr<GS::ModelGridDeltaChange> GridChange = Internal->EditSM.EndTrackedChange();
+		if (GridChange)
+		{
+			TUniquePtr<FModelGrid_GridDeltaChange> DeltaChange = MakeUnique<FModelGrid_GridDeltaChange>();
+			FModelGridInternal::CompressTrackedChange(*GridChange, DeltaChange->CellDeltas);
+			GS::ModelGridDeltaChange::DeleteChangeFromExternalDLL(GridChange.release());
+			if (DeltaChange->CellDeltas.IsEmpty() == false)
+				GetToolManager()->EmitObjectChange(this, MoveTemp(DeltaChange), LOCTEXT("ModelGrid_ModelEdit", "Edit Grid"));
+		}
 	}
 
 	check(Internal->EditSM.IsTrackingChange() == false);
@@ -1478,7 +1631,7 @@ void UModelGridEditorTool::OnEndDrag(const FRay& Ray, const FVector2d& ScreenPos
 
 	EndGridChange();
 
-	ValidatePreviewMesh();
+	ValidatePreviewMesh(true);
 	PreviewGeometry->BeginCollisionUpdate();
 	UpdateCollider();
 
@@ -1889,7 +2042,7 @@ void UModelGridEditorTool::ForceUpdateOnUndoRedo()
 	Internal->AccumulateMeshUpdateRegion();
 
 	bPreviewMeshDirty = true;
-	ValidatePreviewMesh();
+	ValidatePreviewMesh(true);
 	PreviewGeometry->BeginCollisionUpdate();
 	UpdateCollider();
 	GridTimestamp++;
@@ -2224,6 +2377,47 @@ void UModelGridEditorTool::UpdateDrawPreviewMesh()
 	TempMeshBuilder = nullptr;
 }
 
+void UModelGridEditorTool::UpdateDrawPreviewCellsComponent()
+{
+	if (DrawPreviewCellsComponent == nullptr)
+		return;
+
+	// draw preview of potentially-affected cells. this is not very nice but it works for now.
+	// should probably be refactored into the Interaction somehow...
+	bool bShowPreviewCells = bHovering && bHaveValidHoverCell && DrawPreviewCells.size() > 0;
+	DrawPreviewCellsComponent->SetVisibility(bShowPreviewCells);
+	if (bShowPreviewCells == false)
+		return;
+
+	Vector3d DrawPlaneOffset = -Internal->EditSM.GetActiveDrawPlaneNormal() * Internal->Builder.GetCellDimensions() * 0.5;
+	if ( InModifyExistingOperationMode() )
+		DrawPlaneOffset = -DrawPlaneOffset;
+	if (ModelSettings->DrawMode == EModelGridDrawMode::FloodFill2D || ModelSettings->DrawMode == EModelGridDrawMode::Brush2D || ModelSettings->DrawMode == EModelGridDrawMode::Brush3D || ModelSettings->DrawMode == EModelGridDrawMode::Rect2D)
+		DrawPlaneOffset = Vector3d::Zero();
+	FLinearColor PreviewColor = (ModelSettings->EditType == EModelGridDrawEditType::Erase || bCtrlToggle) ? FLinearColor(0.0f, 0.0f, 0.0f) : FLinearColor(0.95f, 0.1f, 0.0f);
+
+	// only re-upload the points if the preview has changed
+	bool bPreviewChanged = DrawPreviewCells.size() != UploadedPreviewCells.size()
+		|| FMemory::Memcmp(DrawPreviewCells.data(), UploadedPreviewCells.data(), DrawPreviewCells.size() * sizeof(Vector3i)) != 0
+		|| (FVector)DrawPlaneOffset != UploadedPreviewCellsOffset
+		|| PreviewColor != UploadedPreviewCellsColor;
+	if (bPreviewChanged == false)
+		return;
+
+	UploadedPreviewCells = DrawPreviewCells;
+	UploadedPreviewCellsOffset = (FVector)DrawPlaneOffset;
+	UploadedPreviewCellsColor = PreviewColor;
+
+	FColor PointColor = PreviewColor.ToFColor(true);
+	DrawPreviewCellsComponent->Clear();
+	DrawPreviewCellsComponent->ReservePoints((int32)DrawPreviewCells.size());
+	for (Vector3i CellIndex : DrawPreviewCells) {
+		AxisBox3d CellBox = Internal->Builder.GetCellLocalBounds(CellIndex);
+		DrawPreviewCellsComponent->AddPoint(FRenderablePoint((FVector)(CellBox.Center() + DrawPlaneOffset), PointColor, 2.0f));
+	}
+}
+
+
 // 
 void UModelGridEditorTool::UpdateDrawPreviewVisualization()
 {
@@ -2622,17 +2816,34 @@ void UModelGridEditorTool::InitializeInteractions()
 
 void FModelGrid_GridDeltaChange::Apply(UObject* Object)
 {
-	if (UModelGridEditorTool* Tool = Cast<UModelGridEditorTool>(Object))
-	{
-		Tool->Internal->EditSM.ReapplyChange(*GridChange, false);
-		Tool->ForceUpdateOnUndoRedo();
-	}
+	ApplyToTool(Object, false);
 }
 void FModelGrid_GridDeltaChange::Revert(UObject* Object)
+{
+	ApplyToTool(Object, true);
+}
+void FModelGrid_GridDeltaChange::ApplyToTool(UObject* Object, bool bRevert)
 {
 	if (UModelGridEditorTool* Tool = Cast<UModelGridEditorTool>(Object))
 	{
-		Tool->Internal->EditSM.ReapplyChange(*GridChange, true);
+		ModelGridEditor Editor(Tool->Internal->Builder);
+		CellDeltas.EnumerateDeltas([&](const Vector3i& CellIndex, const ModelGridCell& Before, const ModelGridCell& After)
+		{
+			const ModelGridCell& Cell = (bRevert) ? Before : After;
+			if (Cell.CellType == EModelGridCellType::Empty)
+				Editor.EraseCell(CellIndex);
+			else
+				Editor.UpdateCell(CellIndex, Cell);
+		});
+
+		// the edits bypass EditSM, so the modified blocks must be added to the dirty regions here
+		const int BlockSize = FModelGridChangeJournal::BlockSize;
+		for (const GS::FCompressedModelGridCellDeltas::FBlock& Block : CellDeltas.Blocks)
+		{
+			Vector3i BlockMin(Block.BlockIndex.X * BlockSize, Block.BlockIndex.Y * BlockSize, Block.BlockIndex.Z * BlockSize);
+			Tool->Internal->AddModifiedRegion(AxisBox3i(BlockMin, BlockMin + Vector3i(BlockSize - 1, BlockSize - 1, BlockSize - 1)));
+		}
+
 		Tool->ForceUpdateOnUndoRedo();
 	}
 }
@@ -27,6 +27,7 @@
 #include "ModelGridEditorTool.generated.h"
 
 class UPreviewMesh;
+class UPointSetComponent;
 class UGSModelGridPreview;
 class UConstructionPlaneMechanic;
 class UDragAlignmentMechanic;
@@ -691,7 +692,8 @@ protected:
 
 	bool bPreviewMeshDirty = false;
 	int GridTimestamp = -1;
-	void ValidatePreviewMesh();
+	//! @param bWaitForColumnUpdates if true, column meshes are updated before returning, otherwise they are published on a later tick
+	void ValidatePreviewMesh(bool bWaitForColumnUpdates = false);
 
 	UPROPERTY()
 	TObjectPtr<UGSGridMaterialSet> GridMaterialSet;
@@ -725,6 +727,14 @@ protected:
 	std::vector<GS::Vector3i> DrawPreviewCells;
 	void UpdateDrawPreviewVisualization();
 
+	// draws DrawPreviewCells as a single batched point set. Points are only re-uploaded when the preview changes.
+	UPROPERTY()
+	TObjectPtr<UPointSetComponent> DrawPreviewCellsComponent;
+	std::vector<GS::Vector3i> UploadedPreviewCells;
+	FVector UploadedPreviewCellsOffset = FVector::ZeroVector;
+	FLinearColor UploadedPreviewCellsColor = FLinearColor::Black;
+	void UpdateDrawPreviewCellsComponent();
+
 	friend class FModelGrid_GridDeltaChange;
 	void ForceUpdateOnUndoRedo();
 	void BeginGridChange();
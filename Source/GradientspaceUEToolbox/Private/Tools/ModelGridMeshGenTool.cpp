@@ -172,10 +172,7 @@ void UModelGridMeshGenTool::Setup()
 	if (InitFromActor)
 	{
 		UGSModelGrid* ModelGridContainer = InitFromActor->GetGrid();
-		ModelGridContainer->ProcessGrid([&](const ModelGrid& SourceGrid)
-		{
-			SourceData->SourceGrid = SourceGrid;
-		});
+		SourceData->SourceGrid = ModelGridContainer->GetGridSnapshot();
 
 		UGSGridMaterialSet* MaterialSet = InitFromActor->GetGridComponent()->GetGridMaterials();
 		FReferenceSetMaterialMap GridMaterialMap;